@@ -0,0 +1,423 @@
+#!/usr/bin/env python
+'''
+    WSkS Bench Runner
+
+    @author: Tomas Fiedor, ifiedortom@fit.vutbr.cz
+    @summary: Runs the benchmark families in parallel with limited resources,
+        stores the results keyed by commit and compares them with baseline
+
+'''
+
+from __future__ import print_function
+
+import argparse
+import csv
+import json
+import os
+import re
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+from collections import OrderedDict
+from multiprocessing import cpu_count
+from multiprocessing.pool import ThreadPool
+from termcolor import colored
+
+ok_status = 'ok'
+timeout_status = 'timeout'
+memout_status = 'memout'
+crash_status = 'crash'
+
+csv_fields = ['benchmark', 'status', 'result', 'time', 'cpu-time', 'peak-rss', 'terms', 'time-parse', 'time-preprocess',
+              'time-construction', 'time-deciding']
+plot_measures = [('time', 's'), ('peak-rss', 'kB'), ('terms', '')]
+
+
+def createArgumentParser():
+    '''
+    Creates Argument Parser object
+    '''
+    parser = argparse.ArgumentParser("WSkS Bench Runner")
+    parser.add_argument('--dir', '-d', default=(os.path.join(os.curdir, "benchmarks")), help="directory with benchmarks")
+    parser.add_argument('--skip', '-s', action='append', default=['ws2s'], help='skips benchmarks with tag [SKIP]')
+    parser.add_argument('--only', '-o', default=None, help='only run the benchmarks matching regex ONLY')
+    parser.add_argument('--bin', '-b', default=os.path.join(os.curdir, "gaston"), help='gaston binary')
+    parser.add_argument('--args', '-a', default="", help='additional arguments passed to gaston')
+    parser.add_argument('--jobs', '-j', type=int, default=cpu_count(), help='number of parallel jobs')
+    parser.add_argument('--timeout', '-t', type=float, default=60.0, help='wall-clock limit of one job in seconds')
+    parser.add_argument('--cpu-limit', '-c', type=int, default=None, help='cpu time limit of one job in seconds')
+    parser.add_argument('--mem-limit', '-m', type=int, default=4096, help='memory (address space) limit of one job in MB')
+    parser.add_argument('--results', '-r', default=os.path.join(os.curdir, "bench-results"),
+                        help='directory where the results are stored')
+    parser.add_argument('--commit', default=None, help='key of the results [current git commit]')
+    parser.add_argument('--baseline', '-B', default=None, help='commit key or results file to compare with')
+    parser.add_argument('--time-threshold', type=float, default=1.10, help='ratio of time that is reported as slowdown')
+    parser.add_argument('--time-noise', type=float, default=0.05, help='slowdowns smaller than this (in s) are ignored')
+    parser.add_argument('--mem-threshold', type=float, default=1.10, help='ratio of peak RSS that is reported as growth')
+    parser.add_argument('--mem-noise', type=int, default=1024, help='growth smaller than this (in kB) is ignored')
+    parser.add_argument('--fail-on-regression', action='store_true', help='returns non-zero if regression is found')
+    parser.add_argument('--plot', '-p', action='store_true',
+                        help='plots time, memory and terms against the parameter of scaling series (with manifest.json)')
+    return parser
+
+
+def getTagsFromString(string):
+    '''
+    Finds all tags from file
+
+    @param string: string we are getting tags from
+    @return: list of string tags
+    '''
+    tags = re.findall(r"\[[a-zA-Z0-9]+\]", string)
+    return [tag[1:-1] for tag in tags]
+
+
+def collectBenchmarks(options):
+    '''
+    Collects the formulae from the benchmark families in directory
+
+    @param options: parsed arguments
+    @return: sorted list of paths to benchmarks
+    '''
+    benchmarks = []
+    for root, dirs, filenames in os.walk(options.dir):
+        for f in filenames:
+            benchmark = os.path.join(root, f)
+            if not benchmark.endswith('.mona'):
+                continue
+            if any([tag in options.skip for tag in getTagsFromString(benchmark)]):
+                continue
+            if options.only is not None and re.search(options.only, benchmark) is None:
+                continue
+            benchmarks.append(benchmark)
+    return sorted(benchmarks)
+
+
+def currentCommit():
+    '''
+    @return: short hash of the HEAD commit with '-dirty' suffix for modified tree, or 'unknown' outside of git
+    '''
+    try:
+        with open(os.devnull, 'w') as devnull:
+            commit = subprocess.check_output(['git', 'rev-parse', '--short', 'HEAD'], stderr=devnull).decode().strip()
+            dirty = subprocess.call(['git', 'diff', '--quiet', 'HEAD', '--'], stdout=devnull, stderr=devnull) != 0
+        return commit + ('-dirty' if dirty else '')
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+# Sets the rlimits in new session and execs the command given after the limits (-1 for no limit); the
+# limits are set by wrapper, since preexec_fn of Popen is not safe to use from the threads of the pool
+limit_wrapper = '''
+import os, resource, sys
+cpu, mem = int(sys.argv[1]), int(sys.argv[2])
+os.setsid()
+if cpu >= 0:
+    resource.setrlimit(resource.RLIMIT_CPU, (cpu, cpu + 1))
+if mem >= 0:
+    resource.setrlimit(resource.RLIMIT_AS, (mem, mem))
+resource.setrlimit(resource.RLIMIT_CORE, (0, 0))
+os.execvp(sys.argv[3], sys.argv[3:])
+'''
+
+
+def limitResources(command, options):
+    '''
+    Wraps the command so it is run in new session with the rlimits set
+
+    @param command: list of command and its arguments
+    @param options: parsed arguments
+    @return: wrapped command
+    '''
+    cpu = options.cpu_limit if options.cpu_limit is not None else -1
+    mem = options.mem_limit * 1024 * 1024 if options.mem_limit is not None else -1
+    return [sys.executable, '-c', limit_wrapper, str(cpu), str(mem)] + command
+
+
+def parseGastonOutput(output, profile):
+    '''
+    Parses the result of the decision procedure from output and times and memory of phases from the JSON profile
+
+    @param output: stdout of gaston
+    @param profile: path to the profile written by gaston (--profile)
+    @return: dictionary with measures
+    '''
+    data = {'result': "", 'peak-rss': 0}
+    match = re.search(r"\[!\] Formula is [^']*'([A-Z]+)'", output)
+    if match is not None:
+        data['result'] = match.group(1)
+
+    # number of created terms is reported in the measured state space (printed with MEASURE_STATE_SPACE)
+    match = re.search(r"\[\*\] Overall State Space: ([0-9]+)", output)
+    if match is not None:
+        data['terms'] = int(match.group(1))
+    for (name, count) in re.findall(r"Term (Products|Bases|Fixpoints|Lists|Continuations): ([0-9]+)", output):
+        data['terms-' + name[:-1].lower()] = int(count)
+
+    try:
+        with open(profile, 'r') as profileFile:
+            parsed = json.load(profileFile)
+        data['peak-rss'] = parsed.get('peakRssKB', 0)
+        for phase in parsed.get('phases', []):
+            if phase['depth'] == 0:
+                data['time-' + phase['name'].lower()] = phase['ns'] / 1e9
+    except (IOError, OSError, ValueError):
+        pass
+    return data
+
+
+def runBenchmark(args):
+    '''
+    Runs gaston on one benchmark under the resource limits
+
+    @param args: pair of benchmark and options
+    @return: dictionary with measures of the run
+    '''
+    benchmark, options = args
+    outFd, outPath = tempfile.mkstemp(prefix='gaston-out-')
+    profileFd, profilePath = tempfile.mkstemp(prefix='gaston-profile-', suffix='.json')
+    os.close(profileFd)
+
+    command = [options.bin, '--time', '--quiet', '--profile={}'.format(profilePath)] + options.args.split() + [benchmark]
+    start = time.time()
+    proc = subprocess.Popen(limitResources(command, options), stdout=outFd, stderr=subprocess.STDOUT)
+    os.close(outFd)
+
+    # wait4 is used instead of Popen.wait, so the resource usage of this very child is obtained
+    timedOut = False
+    while True:
+        pid, waitStatus, usage = os.wait4(proc.pid, os.WNOHANG)
+        if pid != 0:
+            break
+        if time.time() - start > options.timeout:
+            timedOut = True
+            os.killpg(proc.pid, signal.SIGKILL)
+            pid, waitStatus, usage = os.wait4(proc.pid, 0)
+            break
+        time.sleep(0.01)
+    elapsed = time.time() - start
+    proc.returncode = os.WEXITSTATUS(waitStatus) if os.WIFEXITED(waitStatus) else -os.WTERMSIG(waitStatus)
+
+    with open(outPath, 'rb') as outFile:
+        output = outFile.read().decode('utf-8', 'replace')
+    data = parseGastonOutput(output, profilePath)
+    os.remove(outPath)
+    os.remove(profilePath)
+
+    data['benchmark'] = benchmark
+    data['time'] = elapsed
+    data['cpu-time'] = usage.ru_utime + usage.ru_stime
+    # ru_maxrss is the peak of the process, the profile is not written if the run crashed
+    data['peak-rss'] = max(data['peak-rss'], usage.ru_maxrss)
+
+    cpuLimitHit = os.WIFSIGNALED(waitStatus) and os.WTERMSIG(waitStatus) in (signal.SIGXCPU, signal.SIGKILL)
+    if timedOut or (options.cpu_limit is not None and cpuLimitHit):
+        data['status'] = timeout_status
+    elif proc.returncode != 0 and re.search("bad_alloc|out of memory|Cannot allocate", output, re.IGNORECASE):
+        data['status'] = memout_status
+    elif proc.returncode != 0 or data['result'] == "":
+        data['status'] = crash_status
+    else:
+        data['status'] = ok_status
+    return data
+
+
+def storeResults(results, options, commit):
+    '''
+    Stores the results as JSON and CSV keyed by commit
+
+    @param results: list of dictionaries with measures
+    @param options: parsed arguments
+    @param commit: key of the results
+    @return: path to the JSON file
+    '''
+    if not os.path.isdir(options.results):
+        os.makedirs(options.results)
+    jsonPath = os.path.join(options.results, commit + '.json')
+    csvPath = os.path.join(options.results, commit + '.csv')
+
+    with open(jsonPath, 'w') as jsonFile:
+        json.dump({'commit': commit, 'date': time.strftime('%Y-%m-%d %H:%M:%S'), 'args': options.args,
+                   'benchmarks': OrderedDict((data['benchmark'], data) for data in results)},
+                  jsonFile, indent=2, sort_keys=True)
+    with open(csvPath, 'w') as csvFile:
+        writer = csv.DictWriter(csvFile, fieldnames=csv_fields, extrasaction='ignore')
+        writer.writeheader()
+        for data in results:
+            writer.writerow(dict((field, data.get(field, "")) for field in csv_fields))
+    return jsonPath
+
+
+def loadBaseline(options):
+    '''
+    @param options: parsed arguments
+    @return: dictionary of baseline results keyed by benchmark
+    '''
+    path = options.baseline
+    if not os.path.isfile(path):
+        path = os.path.join(options.results, options.baseline + '.json')
+    with open(path, 'r') as baselineFile:
+        return json.load(baselineFile)['benchmarks']
+
+
+def compareWithBaseline(results, baseline, options):
+    '''
+    Compares the results with the baseline and prints slowdowns, memory growth and changed results per formula
+
+    @param results: list of dictionaries with measures
+    @param baseline: dictionary of baseline results keyed by benchmark
+    @param options: parsed arguments
+    @return: number of regressions
+    '''
+    regressions = 0
+    print("[*] Comparison with baseline '{}':".format(options.baseline))
+    for data in results:
+        old = baseline.get(data['benchmark'])
+        if old is None:
+            continue
+
+        issues = []
+        if old['status'] == ok_status and data['status'] != ok_status:
+            issues.append("{} (was ok)".format(data['status']))
+        elif old['status'] == ok_status and data['result'] != old['result']:
+            issues.append("result {} (was {})".format(data['result'], old['result']))
+        if data['status'] == ok_status and old['status'] == ok_status:
+            if data['time'] > old['time'] * options.time_threshold and data['time'] - old['time'] > options.time_noise:
+                issues.append("slowdown {:.2f}s -> {:.2f}s ({:+.1f}%)".format(
+                    old['time'], data['time'], (data['time'] / max(old['time'], 1e-6) - 1) * 100))
+            if data['peak-rss'] > old['peak-rss'] * options.mem_threshold and \
+                    data['peak-rss'] - old['peak-rss'] > options.mem_noise:
+                issues.append("memory {}MB -> {}MB ({:+.1f}%)".format(
+                    old['peak-rss'] // 1024, data['peak-rss'] // 1024, (data['peak-rss'] / float(max(old['peak-rss'], 1)) - 1) * 100))
+
+        if issues:
+            regressions += 1
+            print("\t->", colored("REGRESSION", "red"), "'{}': {}".format(data['benchmark'], "; ".join(issues)))
+        elif data['status'] == ok_status and old['status'] != ok_status:
+            print("\t->", colored("FIXED", "green"), "'{}': {} (was {})".format(data['benchmark'], data['status'], old['status']))
+    return regressions
+
+
+def loadManifests(options):
+    '''
+    Loads the manifests of the scaling series generated by testgen.py --series
+
+    @param options: parsed arguments
+    @return: list of pairs (series directory, manifest)
+    '''
+    manifests = []
+    for root, dirs, filenames in os.walk(options.dir):
+        if 'manifest.json' in filenames:
+            with open(os.path.join(root, 'manifest.json'), 'r') as manifestFile:
+                manifests.append((root, json.load(manifestFile)))
+    return sorted(manifests, key=lambda pair: pair[0])
+
+
+def plotSeries(results, options, commit):
+    '''
+    Plots time, peak memory and number of terms against the swept parameter of each scaling series. The points
+    are stored as CSV, plotted to PNG if matplotlib is available and always printed as table with growth factors
+    between consecutive points (constant factor > 1 means exponential growth in the parameter).
+
+    @param results: list of dictionaries with measures
+    @param options: parsed arguments
+    @param commit: key of the results
+    '''
+    byPath = dict((os.path.normpath(data['benchmark']), data) for data in results)
+    for (directory, manifest) in loadManifests(options):
+        points = []
+        for formula in manifest['formulae']:
+            data = byPath.get(os.path.normpath(os.path.join(directory, formula['file'])))
+            if data is not None:
+                points.append((formula['value'], data))
+        if not points:
+            continue
+        points.sort(key=lambda point: point[0])
+
+        seriesPath = os.path.join(options.results, "{}-{}".format(commit, manifest['series']))
+        with open(seriesPath + '.csv', 'w') as csvFile:
+            writer = csv.writer(csvFile)
+            writer.writerow([manifest['parameter'], 'status'] + [measure for (measure, _) in plot_measures])
+            for (value, data) in points:
+                writer.writerow([value, data['status']] + [data.get(measure, "") for (measure, _) in plot_measures])
+
+        print("[*] Series '{}' ({} = {}):".format(manifest['series'], manifest['parameter'],
+              ", ".join("{}={}".format(k, v) for (k, v) in sorted(manifest['fixed'].items()))))
+        print("\t{:>8}  {:>8}  {:>18}  {:>18}  {:>18}".format(manifest['parameter'], 'status', *[m for (m, _) in plot_measures]))
+        previous = {}
+        for (value, data) in points:
+            columns = []
+            for (measure, unit) in plot_measures:
+                current = data.get(measure)
+                if current is None or data['status'] != ok_status:
+                    columns.append("-")
+                    previous.pop(measure, None)
+                    continue
+                growth = " (x{:.2f})".format(current / float(previous[measure])) if previous.get(measure) else ""
+                columns.append(("{:.2f}" if isinstance(current, float) else "{}").format(current) + unit + growth)
+                previous[measure] = current
+            print("\t{:>8}  {:>8}  {:>18}  {:>18}  {:>18}".format(value, data['status'], *columns))
+
+        try:
+            import matplotlib
+            matplotlib.use('Agg')
+            import matplotlib.pyplot as pyplot
+        except ImportError:
+            continue
+        figure, axes = pyplot.subplots(1, len(plot_measures), figsize=(5 * len(plot_measures), 4))
+        for (axis, (measure, unit)) in zip(axes, plot_measures):
+            measured = [(value, data[measure]) for (value, data) in points if data['status'] == ok_status and data.get(measure)]
+            if measured:
+                axis.plot([value for (value, _) in measured], [y for (_, y) in measured], marker='o')
+                axis.set_yscale('log')
+            axis.set_xlabel(manifest['parameter'])
+            axis.set_ylabel(measure + (" [{}]".format(unit) if unit else ""))
+        figure.suptitle("{} ({})".format(manifest['series'], commit))
+        figure.tight_layout()
+        figure.savefig(seriesPath + '.png')
+        pyplot.close(figure)
+        print("[*] Plot stored in '{}.png'".format(seriesPath))
+
+
+def parse_arguments():
+    '''
+    Parse input arguments
+    '''
+    parser = createArgumentParser()
+    return parser.parse_args()
+
+
+if __name__ == '__main__':
+    options = parse_arguments()
+    commit = options.commit if options.commit is not None else currentCommit()
+
+    print("[*] WSkS Bench Runner")
+    print("[c] Tomas Fiedor, ifiedortom@fit.vutbr.cz")
+
+    benchmarks = collectBenchmarks(options)
+    print("[*] Running {} benchmarks in {} jobs (commit '{}')".format(len(benchmarks), options.jobs, commit))
+
+    results = []
+    pool = ThreadPool(max(1, options.jobs))
+    for data in pool.imap_unordered(runBenchmark, [(benchmark, options) for benchmark in benchmarks]):
+        results.append(data)
+        status = colored(data['status'].upper(), "green" if data['status'] == ok_status else "red")
+        print("\t-> [{}/{}] {} '{}': {} in {:.2f}s, {}MB".format(
+            len(results), len(benchmarks), status, data['benchmark'], data['result'] or "-", data['time'],
+            data['peak-rss'] // 1024))
+    pool.close()
+    pool.join()
+    results.sort(key=lambda data: data['benchmark'])
+
+    path = storeResults(results, options, commit)
+    print("[*] Results stored in '{}'".format(path))
+    if options.plot:
+        plotSeries(results, options, commit)
+
+    if options.baseline is not None:
+        regressions = compareWithBaseline(results, loadBaseline(options), options)
+        print("[*] {} regression{} found".format(regressions, "" if regressions == 1 else "s"))
+        if regressions != 0 and options.fail_on_regression:
+            sys.exit(1)
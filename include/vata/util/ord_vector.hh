@@ -18,10 +18,19 @@
 // Standard library headers
 #include <vector>
 #include <algorithm>
+#include <cstdint>
+#include <type_traits>
 
 // Boost headers
 #include <boost/functional/hash.hpp>
 
+// SIMD headers (the kernels fall back to scalar code, if not available)
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSE4_1__)
+	#include <smmintrin.h>
+#endif
+
 
 // insert the class into proper namespace
 namespace VATA
@@ -32,6 +41,216 @@ namespace VATA
 			class Key
 		>
 		class OrdVector;
+
+		/**
+		 * @brief  Kernels for operations over sorted arrays without duplicates
+		 *
+		 * The elements of the smaller array are searched in the bigger array by
+		 * skipping whole blocks of elements that are smaller than the searched
+		 * one; the block containing the searched element is then compared at once
+		 * by SIMD instructions (AVX2 or SSE4.1), if these are available and the
+		 * keys are 64-bit integers. Otherwise plain scalar code is used.
+		 */
+		namespace SortedKernels
+		{
+#if defined(__AVX2__)
+			const size_t Lanes = 4;
+#elif defined(__SSE4_1__)
+			const size_t Lanes = 2;
+#else
+			const size_t Lanes = 1;
+#endif
+
+			template <class Key>
+			struct IsVectorizable
+			{
+				static const bool value = (Lanes > 1) &&
+					std::is_integral<Key>::value && (sizeof(Key) == sizeof(std::int64_t));
+			};
+
+			template <class Key>
+			inline unsigned BlockMatch(const Key* block, const Key& key,
+				std::false_type /* vectorizable */)
+			{
+				unsigned mask = 0;
+				for (size_t i = 0; i < Lanes; ++i)
+				{
+					mask |= static_cast<unsigned>(block[i] == key) << i;
+				}
+
+				return mask;
+			}
+
+			/**
+			 * @brief  Returns the mask of lanes of @p block equal to @p key
+			 */
+			template <class Key>
+			inline unsigned BlockMatch(const Key* block, const Key& key,
+				std::true_type /* vectorizable */)
+			{
+#if defined(__AVX2__)
+				__m256i needle = _mm256_set1_epi64x(static_cast<long long>(key));
+				__m256i hay = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+				return static_cast<unsigned>(_mm256_movemask_pd(
+					_mm256_castsi256_pd(_mm256_cmpeq_epi64(needle, hay))));
+#elif defined(__SSE4_1__)
+				__m128i needle = _mm_set1_epi64x(static_cast<long long>(key));
+				__m128i hay = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+				return static_cast<unsigned>(_mm_movemask_pd(
+					_mm_castsi128_pd(_mm_cmpeq_epi64(needle, hay))));
+#else
+				return BlockMatch(block, key, std::false_type());
+#endif
+			}
+
+			/**
+			 * @brief  Searches @p key in the sorted array @p big from position @p pos
+			 *
+			 * @param[in]      big   Sorted array
+			 * @param[in]      size  Size of @p big
+			 * @param[in,out]  pos   Starting position, moved to the first element not
+			 *                       smaller than @p key
+			 * @param[in]      key   Searched key
+			 *
+			 * @returns  True if @p key is in @p big
+			 */
+			template <class Key>
+			inline bool Seek(const Key* big, size_t size, size_t& pos, const Key& key)
+			{
+				if (Lanes > 1)
+				{
+					while ((pos + Lanes <= size) && (big[pos + Lanes - 1] < key))
+					{	// skip the blocks that are smaller than key
+						pos += Lanes;
+					}
+
+					if (pos + Lanes <= size)
+					{	// the block now contains an element that is not smaller than key
+						unsigned mask = BlockMatch(&big[pos], key,
+							std::integral_constant<bool, IsVectorizable<Key>::value>());
+						if (mask != 0)
+						{
+							pos += __builtin_ctz(mask);
+							return true;
+						}
+					}
+				}
+
+				while ((pos < size) && (big[pos] < key))
+				{
+					++pos;
+				}
+
+				return (pos < size) && (big[pos] == key);
+			}
+
+			/**
+			 * @brief  Tests whether sorted @p small is included in sorted @p big
+			 */
+			template <class Key>
+			inline bool Includes(const Key* small, size_t smallSize,
+				const Key* big, size_t bigSize)
+			{
+				if (smallSize > bigSize)
+				{
+					return false;
+				}
+
+				size_t pos = 0;
+				for (size_t i = 0; i < smallSize; ++i)
+				{
+					if (!Seek(big, bigSize, pos, small[i]))
+					{
+						return false;
+					}
+					++pos;
+				}
+
+				return true;
+			}
+
+			/**
+			 * @brief  Tests whether sorted @p lhs and @p rhs share an element
+			 */
+			template <class Key>
+			inline bool Intersects(const Key* lhs, size_t lhsSize,
+				const Key* rhs, size_t rhsSize)
+			{
+				if (lhsSize > rhsSize)
+				{
+					return Intersects(rhs, rhsSize, lhs, lhsSize);
+				}
+
+				size_t pos = 0;
+				for (size_t i = 0; (i < lhsSize) && (pos < rhsSize); ++i)
+				{
+					if (Seek(rhs, rhsSize, pos, lhs[i]))
+					{
+						return true;
+					}
+				}
+
+				return false;
+			}
+
+			/**
+			 * @brief  Appends the intersection of sorted @p lhs and @p rhs to @p result
+			 */
+			template <class Key>
+			inline void Intersection(const Key* lhs, size_t lhsSize,
+				const Key* rhs, size_t rhsSize, std::vector<Key>& result)
+			{
+				if (lhsSize > rhsSize)
+				{
+					Intersection(rhs, rhsSize, lhs, lhsSize, result);
+					return;
+				}
+
+				size_t pos = 0;
+				for (size_t i = 0; (i < lhsSize) && (pos < rhsSize); ++i)
+				{
+					if (Seek(rhs, rhsSize, pos, lhs[i]))
+					{
+						result.push_back(lhs[i]);
+						++pos;
+					}
+				}
+			}
+
+			/**
+			 * @brief  Appends the union of sorted @p lhs and @p rhs to @p result
+			 *
+			 * The merge is kept scalar: SIMD merging networks do not pay off for
+			 * the short sets of states we usually merge.
+			 */
+			template <class Key>
+			inline void Union(const Key* lhs, size_t lhsSize,
+				const Key* rhs, size_t rhsSize, std::vector<Key>& result)
+			{
+				result.reserve(result.size() + lhsSize + rhsSize);
+
+				size_t i = 0, j = 0;
+				while ((i < lhsSize) && (j < rhsSize))
+				{
+					if (lhs[i] < rhs[j])
+					{
+						result.push_back(lhs[i++]);
+					}
+					else if (rhs[j] < lhs[i])
+					{
+						result.push_back(rhs[j++]);
+					}
+					else
+					{	// in case they are equal
+						result.push_back(lhs[i++]);
+						++j;
+					}
+				}
+
+				result.insert(result.end(), lhs + i, lhs + lhsSize);
+				result.insert(result.end(), rhs + j, rhs + rhsSize);
+			}
+		}
 	}
 }
 
@@ -244,50 +463,92 @@ public:   // Public methods
 		//assert(vectorIsSorted());
 		//assert(rhs.vectorIsSorted());
 
-		VectorType newVector;
+		OrdVector result;
+		SortedKernels::Union(vec_.data(), vec_.size(),
+			rhs.vec_.data(), rhs.vec_.size(), result.vec_);
+
+		// Assertions
+		//assert(result.vectorIsSorted());
 
-		auto lhsIt = vec_.begin();
-		auto rhsIt = rhs.vec_.begin();
+		return result;
+	}
 
-		while ((lhsIt != vec_.end()) || (rhsIt != rhs.vec_.end()))
-		{	// until we get to the end of both vectors
-			if (lhsIt == vec_.end())
-			{	// if we are finished with the left-hand side vector
-				newVector.push_back(*rhsIt);
-				++rhsIt;
-			}
-			else if (rhsIt == rhs.vec_.end())
-			{	// if we are finished with the right-hand side vector
-				newVector.push_back(*lhsIt);
-				++lhsIt;
+	OrdVector Intersection(const OrdVector& rhs) const
+	{
+		// Assertions
+		//assert(vectorIsSorted());
+		//assert(rhs.vectorIsSorted());
+
+		OrdVector result;
+		SortedKernels::Intersection(vec_.data(), vec_.size(),
+			rhs.vec_.data(), rhs.vec_.size(), result.vec_);
+
+		// Assertions
+		//assert(result.vectorIsSorted());
+
+		return result;
+	}
+
+	/**
+	 * @brief  In-place union of all sets in the range
+	 *
+	 * The sets are appended as sorted runs after the current content and the
+	 * neighbouring runs are merged pairwise, so the union of k sets with n
+	 * elements in total is computed in O(n log k) instead of O(n k) for
+	 * repeated binary unions.
+	 *
+	 * @param[in]  first  Iterator to the first set
+	 * @param[in]  last   Iterator past the last set
+	 */
+	template <class SetIterator>
+	void InsertAll(SetIterator first, SetIterator last)
+	{
+		// Assertions
+		//assert(vectorIsSorted());
+
+		std::vector<size_t> runs(1, 0);
+		size_t total = vec_.size();
+		for (SetIterator it = first; it != last; ++it)
+		{
+			total += it->size();
+		}
+		vec_.reserve(total);
+
+		if (!vec_.empty())
+		{
+			runs.push_back(vec_.size());
+		}
+
+		for (SetIterator it = first; it != last; ++it)
+		{
+			if (!it->empty())
+			{
+				vec_.insert(vec_.end(), it->vec_.begin(), it->vec_.end());
+				runs.push_back(vec_.size());
 			}
-			else
+		}
+
+		while (runs.size() > 2)
+		{	// merge the neighbouring runs until a single one remains
+			std::vector<size_t> merged(1, 0);
+			for (size_t i = 2; i < runs.size(); i += 2)
 			{
-				if (*lhsIt < *rhsIt)
-				{
-					newVector.push_back(*lhsIt);
-					++lhsIt;
-				}
-				else if (*rhsIt < *lhsIt)
-				{
-					newVector.push_back(*rhsIt);
-					++rhsIt;
-				}
-				else
-				{	// in case they are equal
-					newVector.push_back(*rhsIt);
-					++rhsIt;
-					++lhsIt;
-				}
+				std::inplace_merge(vec_.begin() + runs[i - 2],
+					vec_.begin() + runs[i - 1], vec_.begin() + runs[i]);
+				merged.push_back(runs[i]);
 			}
+
+			if (runs.size() % 2 == 0)
+			{	// the odd run is left for the next round
+				merged.push_back(runs.back());
+			}
+			runs.swap(merged);
 		}
 
-		OrdVector result(newVector);
+		vec_.erase(std::unique(vec_.begin(), vec_.end()), vec_.end());
 
 		// Assertions
-		//assert(result.vectorIsSorted());
-
-		return result;
+		//assert(vectorIsSorted());
 	}
 
 	const_iterator find(const Key& key) const
@@ -413,8 +674,8 @@ public:   // Public methods
 
 	bool IsSubsetOf(const OrdVector& bigger) const
 	{
-		return std::includes(bigger.cbegin(), bigger.cend(),
-			this->cbegin(), this->cend());
+		return SortedKernels::Includes(vec_.data(), vec_.size(),
+			bigger.vec_.data(), bigger.vec_.size());
 	}
 
 	bool HaveEmptyIntersection(const OrdVector& rhs) const
@@ -423,27 +684,8 @@ public:   // Public methods
 		//assert(vectorIsSorted());
 		//assert(rhs.vectorIsSorted());
 
-		const_iterator itLhs = begin();
-		const_iterator itRhs = rhs.begin();
-
-		while ((itLhs != end()) || (itRhs != rhs.end()))
-		{	// until we drop out of the array (or find a common element)
-			if (*itLhs == *itRhs)
-			{	// in case there exists a common element
-				return false;
-			}
-			else if (*itLhs < *itRhs)
-			{	// in case the element in lhs is smaller
-				++itLhs;
-			}
-			else
-			{	// in case the element in rhs is smaller
-				assert(*itLhs > *itRhs);
-				++itRhs;
-			}
-		}
-
-		return true;
+		return !SortedKernels::Intersects(vec_.data(), vec_.size(),
+			rhs.vec_.data(), rhs.vec_.size());
 	}
 
 	template <typename T>
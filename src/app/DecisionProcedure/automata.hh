@@ -19,6 +19,7 @@
 
 #include "../Frontend/symboltable.h"
 #include "../Frontend/st_dfa.h"
+#include "../Frontend/st_gta.h"
 #include "../Frontend/env.h"
 #include "containers/VarToTrackMap.hh"
 #include "environment.hh"
@@ -29,6 +30,8 @@ extern Options options;
 
 using Automaton = VATA::BDDBottomUpTreeAut;
 
+class TreeAutomaton;
+
 char charToAsgn(char c);
 void addTransition(Automaton& aut, unsigned int q, int x, int y, char* track, int qf);
 void addTransition(Automaton& aut, unsigned int q, int x, char track, int qf);
@@ -39,6 +42,9 @@ void convertMonaToVataAutomaton(Automaton& v_aut, DFA* m_aut, IdentList* vars, i
 void initializeOffsets(unsigned *offs, IdentList *vars);
 IdentList* initializeVars(ASTForm *form);
 void toMonaAutomaton(ASTForm *form, DFA*& dfa, bool);
+void releaseMonaCodes();
+void toMonaGTA(ASTForm *form, GTA*& gta, bool);
+TreeAutomaton* toTreeAutomaton(ASTForm *form);
 void constructAutomatonByMona(ASTForm *form, Automaton& v_aut);
 
 Automaton::SymbolType constructUniversalTrack();
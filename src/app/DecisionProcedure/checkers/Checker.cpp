@@ -8,6 +8,9 @@
 #include "../../Frontend/symboltable.h"
 #include "../containers/VarToTrackMap.hh"
 #include "../environment.hh"
+#include "../utils/VariableOrdering.h"
+#include "../utils/Configuration.h"
+#include "../utils/PhaseProfiler.h"
 
 #include "../visitors/AntiPrenexer.h"
 #include "../visitors/BooleanUnfolder.h"
@@ -30,6 +33,8 @@
 #include "../visitors/FixpointDetagger.h"
 #include "../visitors/MonaSerializer.h"
 #include "../visitors/ShuffleVisitor.h"
+#include "../visitors/LocalRewriter.h"
+#include "../visitors/QuantifierRewriter.h"
 
 extern PredicateLib predicateLib;
 
@@ -41,6 +46,9 @@ extern CodeTable *codeTable;
 
 extern int yyparse(void);
 extern void loadFile(char *filename);
+extern void releaseFiles(unsigned first);
+extern void abortFiles();
+extern void releaseMonaCodes();
 //extern void (*mona_callback)();
 extern Deque<FileSource *> source;
 
@@ -49,17 +57,13 @@ extern char *inputFileName;
 extern Ident lastPosVar, allPosVar;
 
 Checker::~Checker() {
-    // Clean up
+    // Clean up only what was declared by the loaded file, so the symbols and predicates loaded before (e.g. the
+    // prelude of the batch mode) stay available
     delete _monaAST;
-    Deque<FileSource *>::iterator i;
-    for (i = source.begin(); i != source.end(); ++i)
-        delete *i;
-
-    PredLibEntry *pred = predicateLib.first();
-    while(pred != nullptr) {
-        delete pred->ast;
-        pred = predicateLib.next();
-    }
+    releaseMonaCodes();
+    releaseFiles(this->_firstFile);
+    predicateLib.release(this->_firstIdent);
+    symbolTable.release(this->_firstIdent);
 }
 
 /**
@@ -69,9 +73,10 @@ Checker::~Checker() {
  */
 void initializeVarMap(ASTForm* formula) {
     assert(formula != nullptr);
+    PROFILE_PHASE("VarMap");
 
     IdentList free, bound;
-    formula->freeVars(&free, &bound);
+    formula->freeVarsCached(&free, &bound);
 #   if (DEBUG_VARMAP == true)
     std::cout << "Free Variables: "; free.dump(); std::cout << "\n";
     std::cout << "Bound Variables: "; bound.dump(); std::cout << "\n";
@@ -79,7 +84,18 @@ void initializeVarMap(ASTForm* formula) {
 
     IdentList *vars = ident_union(&free, &bound);
     if (vars != nullptr) {
-        varMap.initializeFromList(vars);
+        if(GASTON_OPT(reorderTracks)) {
+            // Variables interacting in atoms are placed on neighbouring tracks (and BDD indices)
+            VariableOrdering ordering(formula, vars);
+            IdentList *ordered = ordering.ComputeOrder();
+#           if (DEBUG_VARMAP == true)
+            ordering.DumpStats();
+#           endif
+            varMap.initializeFromOrder(ordered);
+            delete ordered;
+        } else {
+            varMap.initializeFromList(vars);
+        }
     }
     delete vars;
 }
@@ -155,8 +171,17 @@ void Checker::_stopTimer(Timer &t, char* additionalMessage) {
  * Reads the formulae from file and parses it into the AST representation
  */
 void Checker::LoadFormulaFromFile() {
-    loadFile(inputFileName);
-    yyparse();
+    PROFILE_PHASE("Parse");
+    this->_firstIdent = symbolTable.noIdents;
+    this->_firstFile = source.size();
+    try {
+        loadFile(inputFileName);
+        yyparse();
+    } catch (FrontendError&) {
+        // The scanner is left in the middle of the files
+        abortFiles();
+        throw;
+    }
     this->_monaAST = untypedAST->typeCheck();
     lastPosVar = this->_monaAST->lastPosVar;
     allPosVar = this->_monaAST->allPosVar;
@@ -164,6 +189,21 @@ void Checker::LoadFormulaFromFile() {
     delete untypedAST;
 }
 
+/**
+ * Takes the ownership of the already type checked @p ast (e.g. constructed by the embedding application), whose
+ * identifiers were declared in the symbol table beforehand; these are not released with the checker.
+ *
+ * @param[in] ast:  type checked formula
+ */
+void Checker::LoadFormula(MonaAST* ast) {
+    assert(ast != nullptr);
+    this->_firstIdent = symbolTable.noIdents;
+    this->_firstFile = source.size();
+    this->_monaAST = ast;
+    lastPosVar = this->_monaAST->lastPosVar;
+    allPosVar = this->_monaAST->allPosVar;
+}
+
 /**
  * Closes the prefix of the unground @p formula according tot he list of @p freeVars
  *
@@ -229,36 +269,63 @@ void Checker::CloseUngroundFormula() {
                 break;
             default:
                 // We will test everything
-                ASTForm* restrictions = new ASTForm_True(Pos());
-                for(auto it = freeVars.begin(); it != freeVars.end(); ++it) {
-                    // Fixme: what about zeroorder variables
-                    if(symbolTable.lookupType(*it) == MonaTypeTag::Varname1) {
-                        ASTForm_FirstOrder* fo = new ASTForm_FirstOrder(new ASTTerm1_Var1(*it, Pos()), Pos());
-                        restrictions = new ASTForm_And(fo, restrictions, Pos());
-                        restrictions
-                                = SecondOrderRestricter::RestrictFormula<ASTForm_And, ASTTerm1_Var1>(*it, restrictions);
-                    } else if(symbolTable.lookupType(*it) == MonaTypeTag::Varname2 && *it != allPosVar) {
-                        restrictions
-                                = SecondOrderRestricter::RestrictFormula<ASTForm_And, ASTTerm2_Var2>(*it, restrictions);
-                    }
-                }
-                BooleanUnfolder booleanUnfolder;
-                restrictions = static_cast<ASTForm*>(restrictions->accept(booleanUnfolder));
-                this->_monaAST->formula = new ASTForm_And(restrictions, this->_monaAST->formula, Pos());
+                this->_monaAST->formula = this->_RestrictFreeVariables(&freeVars, this->_monaAST->formula);
                 break;
         }
     }
 }
 
+/**
+ * Restricts the free variables @p freeVars of the @p formula to their domains (e.g. first order variables to
+ * singletons), without closing the formula.
+ *
+ * @param[in] freeVars:     list of free variables
+ * @param[in] formula:      formula we are restricting
+ * @return:                 restricted formula
+ */
+ASTForm* Checker::_RestrictFreeVariables(IdentList* freeVars, ASTForm* formula) {
+    ASTForm* restrictions = new ASTForm_True(Pos());
+    for(auto it = freeVars->begin(); it != freeVars->end(); ++it) {
+        // Fixme: what about zeroorder variables
+        if(symbolTable.lookupType(*it) == MonaTypeTag::Varname1) {
+            ASTForm_FirstOrder* fo = new ASTForm_FirstOrder(new ASTTerm1_Var1(*it, Pos()), Pos());
+            restrictions = new ASTForm_And(fo, restrictions, Pos());
+            restrictions
+                    = SecondOrderRestricter::RestrictFormula<ASTForm_And, ASTTerm1_Var1>(*it, restrictions);
+        } else if(symbolTable.lookupType(*it) == MonaTypeTag::Varname2 && *it != allPosVar) {
+            restrictions
+                    = SecondOrderRestricter::RestrictFormula<ASTForm_And, ASTTerm2_Var2>(*it, restrictions);
+        }
+    }
+    BooleanUnfolder booleanUnfolder;
+    restrictions = static_cast<ASTForm*>(restrictions->accept(booleanUnfolder));
+    return new ASTForm_And(restrictions, formula, Pos());
+}
+
 /**
  * Calls the preprocessing filters according to the list defined in Checker.h. Then calls some additional phases
  * that are common for all of the options of prenexing: tags the nodes by unique ids, then run the detagger to remove
  * some of the tags in order to transform them into the subautomata. Finally everything is restricted to second order.
  */
 void Checker::PreprocessFormula() {
+    PROFILE_PHASE("Preprocess");
+    this->_PreprocessFormula();
+
+    // Table or BDD tracks are reordered
+    initializeVarMap(this->_monaAST->formula);
+
+    if(options.time) {
+        this->_passManager.DumpStats();
+    }
+}
+
+/**
+ * Runs the preprocessing passes on the loaded formula, without initializing the tracks of its variables
+ */
+void Checker::_PreprocessFormula() {
     // Flattening of the formula
     PredicateUnfolder predicateUnfolder;
-    this->_monaAST->formula = static_cast<ASTForm *>((this->_monaAST->formula)->accept(predicateUnfolder));
+    this->_monaAST->formula = this->_passManager.Transform("PredicateUnfolder", this->_monaAST->formula, predicateUnfolder);
 
     if (options.dump) {
         G_DEBUG_FORMULA_AFTER_PHASE("Predicate Unfolding");
@@ -268,7 +335,7 @@ void Checker::PreprocessFormula() {
     // Additional filter phases
     #define CALL_FILTER(filter) \
 		filter filter##_visitor;    \
-		this->_monaAST->formula = static_cast<ASTForm *>(this->_monaAST->formula->accept(filter##_visitor));    \
+		this->_monaAST->formula = this->_passManager.Transform(#filter, this->_monaAST->formula, filter##_visitor);    \
 		if(options.dump) {    \
 			G_DEBUG_FORMULA_AFTER_PHASE(#filter);    \
 			(this->_monaAST->formula)->dump();    std::cout << "\n";    \
@@ -290,25 +357,32 @@ void Checker::PreprocessFormula() {
 
     std::list<size_t> tags;
     std::string stringTag("");
-    readTags(inputFileName, stringTag);
+    if(inputFileName != NULL)
+        readTags(inputFileName, stringTag);
     parseTags(stringTag, tags);
 
     Tagger tagger(tags);
-    (this->_monaAST->formula)->accept(tagger);
+    this->_passManager.Walk("Tagger", this->_monaAST->formula, tagger);
 
     FixpointDetagger detagger;
-    (this->_monaAST->formula)->accept(detagger);
+    this->_passManager.Walk("FixpointDetagger", this->_monaAST->formula, detagger);
 
-#   if (OPT_SHUFFLE_FORMULA == true)
-    ShuffleVisitor shuffleVisitor;
-    this->_monaAST->formula = static_cast<ASTForm*>(this->_monaAST->formula->accept(shuffleVisitor));
-#   endif
+    if(GASTON_OPT(shuffleFormula)) {
+        ShuffleVisitor shuffleVisitor;
+        this->_monaAST->formula = this->_passManager.Transform("ShuffleVisitor", this->_monaAST->formula, shuffleVisitor);
+    }
 
+#   if (OPT_FUSE_LOCAL_REWRITES == true)
+    // Restriction to second order and merging of quantifiers in single traversal
+    QuantifierRewriter quantifierRewriter;
+    this->_monaAST->formula = this->_passManager.Transform("QuantifierRewriter", this->_monaAST->formula, quantifierRewriter);
+#   else
     SecondOrderRestricter restricter;
-    this->_monaAST->formula = static_cast<ASTForm*>((this->_monaAST->formula)->accept(restricter));
+    this->_monaAST->formula = this->_passManager.Transform("SecondOrderRestricter", this->_monaAST->formula, restricter);
 
     QuantificationMerger quantificationMerger;
-    this->_monaAST->formula = static_cast<ASTForm*>((this->_monaAST->formula)->accept(quantificationMerger));
+    this->_monaAST->formula = this->_passManager.Transform("QuantificationMerger", this->_monaAST->formula, quantificationMerger);
+#   endif
 
     if(options.graphvizDAG) {
         std::string dotFileName(inputFileName);
@@ -316,9 +390,6 @@ void Checker::PreprocessFormula() {
         DotWalker dw_visitor(dotFileName);
         (this->_monaAST->formula)->accept(dw_visitor);
     }
-
-    // Table or BDD tracks are reordered
-    initializeVarMap(this->_monaAST->formula);
 }
 
 /**
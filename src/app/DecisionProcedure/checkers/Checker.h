@@ -8,9 +8,12 @@
 #include "../../Frontend/ast.h"
 #include "../../Frontend/timer.h"
 #include "../environment.hh"
+#include "../utils/PassManager.h"
 
 using TimerType = Timer;
 
+void initializeVarMap(ASTForm* formula);
+
 /*******************************
  * DEFINITION OF FILTER PHASES *
  *******************************/
@@ -27,6 +30,14 @@ using TimerType = Timer;
 	code(SyntaxRestricter)				\
 	code(BinaryReorderer)				\
 	code(DistributiveAntiPrenexer)
+#elif (ANTIPRENEXING_FULL == true && OPT_FUSE_LOCAL_REWRITES == true)
+#define FILTER_LIST(code) \
+	code(ZeroOrderRemover)				/* Transform zero-order variables to second-order interpretation */ \
+	code(SyntaxRestricter)				/* Restrict unsupported formula constructs to supported subset*/ \
+	code(BinaryReorderer)				/* Reorder the formula for better antiprenexing */ \
+	code(FullAntiPrenexer)				/* Push quantifiers as deep as possible */ \
+	code(LocalRewriter)					/* Boolean laws, removal of universal quantifiers and negation pushing at once */ \
+	code(BaseAutomataMerger)			/* Merge some of the base automata*/
 #elif (ANTIPRENEXING_FULL == true)
 #define FILTER_LIST(code) \
 	code(ZeroOrderRemover)				/* Transform zero-order variables to second-order interpretation */ \
@@ -50,26 +61,34 @@ using TimerType = Timer;
 class Checker {
 public:
     // <<< PUBLIC CONSTRUCTORS AND DESTRUCTORS >>>
-    Checker() {}
+    Checker() : _monaAST(nullptr), _decision(Decision::INVALID), _firstIdent(0), _firstFile(0) {}
     virtual ~Checker();
 
     // <<< PUBLIC API >>>
     void LoadFormulaFromFile();
+    void LoadFormula(MonaAST* ast);
     void CloseUngroundFormula();
     void PreprocessFormula();
     void CreateAutomataSizeEstimations();
     virtual void ConstructAutomaton() = 0;
     virtual void Decide() = 0;
 	virtual bool Run() = 0;
+	Decision GetDecision() const { return this->_decision; }
 protected:
     // <<< PRIVATE MEMBERS >>>
     MonaAST* _monaAST;
 	bool _printProgress;
 	bool _isGround;
+	Decision _decision;
+	PassManager _passManager;
+	Ident _firstIdent;		// << first identifier declared by the loaded file
+	unsigned _firstFile;	// << number of the first source file of the loaded file
 
 	// <<< PRIVATE METHODS >>>
 	void _startTimer(Timer& t);
 	void _stopTimer(Timer& t, char* s);
+	void _PreprocessFormula();
+	ASTForm* _RestrictFreeVariables(IdentList* freeVars, ASTForm* formula);
 	template<class ZeroOrderQuantifier, class FirstOrderQuantifier, class SecondOrderQuantifier>
 	ASTForm* _ClosePrefix(IdentList* freeVars, ASTForm* formula);
 };
@@ -0,0 +1,358 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: IncrementalChecker.cpp
+ *  Description:
+ *      Incremental deciding of the conjunction of the background formula
+ *      and the stack of conjuncts. Each level of the stack keeps its
+ *      automaton, so pushing a conjunct constructs only the automaton of
+ *      the conjunct and the intersection with the previous level; the
+ *      automata of the lower levels (and their caches) are reused.
+ *****************************************************************************/
+
+#include <unordered_set>
+#include "IncrementalChecker.h"
+#include "../../Frontend/predlib.h"
+#include "../../Frontend/symboltable.h"
+#include "../containers/Term.h"
+#include "../containers/VarToTrackMap.hh"
+#include "../containers/Workshops.h"
+#include "../utils/PhaseProfiler.h"
+
+extern Options options;
+extern PredicateLib predicateLib;
+extern SymbolTable symbolTable;
+extern VarToTrackMap varMap;
+extern Deque<FileSource *> source;
+extern char *inputFileName;
+extern Ident lastPosVar, allPosVar;
+
+extern void releaseFiles(unsigned first);
+extern void releaseMonaCodes();
+
+IncrementalChecker::IncrementalChecker() : SymbolicChecker(), _rootForm(nullptr), _initialOptions(options), _rebuilds(0) {
+    // The checker itself releases only what was declared during the session
+    this->_firstIdent = symbolTable.noIdents;
+    this->_firstFile = source.size();
+}
+
+IncrementalChecker::~IncrementalChecker() {
+    if(this->_automaton != nullptr) {
+        this->_ReleaseAutomaton();
+    }
+    this->_ReleaseAll();
+}
+
+/**
+ * Parses the formula of the level from @p fileName, restricts its free variables and preprocesses it. Conjuncts are
+ * parsed in the scope of the background formula, so they can refer its variables and predicates; the header of
+ * the background (e.g. m2l-str) is desugared only once.
+ *
+ * @param[in] fileName:         file with the formula of the level
+ * @param[in] isBackground:     true if the level is the background formula
+ * @return:                     loaded level without the automaton
+ */
+IncrementalChecker::Level IncrementalChecker::_LoadLevel(const std::string& fileName, bool isBackground) {
+    Level level;
+    level.fileName = fileName;
+
+    char* fileNameBackup = inputFileName;
+    Ident firstIdentBackup = this->_firstIdent, lastPosVarBackup = lastPosVar, allPosVarBackup = allPosVar;
+    unsigned firstFileBackup = this->_firstFile;
+    bool m2lBackup = options.m2l;
+    Mode modeBackup = options.mode;
+    if(isBackground) {
+        options.m2l = this->_initialOptions.m2l;
+        options.mode = this->_initialOptions.mode;
+    } else {
+        options.m2l = false;
+    }
+
+    inputFileName = const_cast<char*>(level.fileName.c_str());
+    this->LoadFormulaFromFile();
+    level.ast = this->_monaAST;
+    level.firstIdent = this->_firstIdent;
+    level.firstFile = this->_firstFile;
+    if(!isBackground) {
+        options.m2l = m2lBackup;
+        options.mode = modeBackup;
+        lastPosVar = lastPosVarBackup;
+        allPosVar = allPosVarBackup;
+    }
+
+    // Free variables are restricted per level, as the restrictions distribute over the conjunction
+    IdentList freeVars, bound;
+    (level.ast->formula)->freeVars(&freeVars, &bound);
+    if(!freeVars.empty() && !(freeVars.size() == 1 && *freeVars.begin() == allPosVar)) {
+        level.ast->formula = this->_RestrictFreeVariables(&freeVars, level.ast->formula);
+    }
+
+    {
+        PROFILE_PHASE("Preprocess");
+        this->_PreprocessFormula();
+    }
+
+    this->_monaAST = nullptr;
+    this->_firstIdent = firstIdentBackup;
+    this->_firstFile = firstFileBackup;
+    inputFileName = fileNameBackup;
+    return level;
+}
+
+/**
+ * Places the variables of the pushed @p formula on the tracks of the current layout. Its free variables have to be
+ * already placed, its bound variables are placed on the tracks of variables, that are not free in any of the
+ * levels: their scopes are in different operands of the conjunction, so they can share the track.
+ *
+ * @param[in] formula:  formula of the pushed conjunct
+ * @return:             false if the formula does not fit the layout
+ */
+bool IncrementalChecker::_PlaceVariables(ASTForm* formula) {
+    IdentList freeVars, bound;
+    formula->freeVars(&freeVars, &bound);
+    for(auto it = freeVars.begin(); it != freeVars.end(); ++it) {
+        if(!varMap.IsIn(*it)) {
+            return false;
+        }
+    }
+
+    // Tracks of variables free in some of the levels are shared by the whole conjunction
+    std::vector<bool> used(varMap.TrackLength(), false);
+    for(auto& level : this->_levels) {
+        IdentList levelFree, levelBound;
+        (level.ast->formula)->freeVars(&levelFree, &levelBound);
+        for(auto it = levelFree.begin(); it != levelFree.end(); ++it) {
+            used[varMap[*it]] = true;
+        }
+    }
+    if(allPosVar != -1 && varMap.IsIn(allPosVar)) {
+        used[varMap[allPosVar]] = true;
+    }
+
+    // Distinct bound variables of the conjunct get distinct tracks
+    std::vector<std::pair<Ident, unsigned int>> placement;
+    for(auto it = bound.begin(); it != bound.end(); ++it) {
+        if(varMap.IsIn(*it)) {
+            used[varMap[*it]] = true;
+        }
+    }
+    size_t track = 0;
+    for(auto it = bound.begin(); it != bound.end(); ++it) {
+        if(varMap.IsIn(*it)) {
+            continue;
+        }
+        while(track < used.size() && used[track]) {
+            ++track;
+        }
+        if(track == used.size()) {
+            return false;
+        }
+        placement.push_back(std::make_pair(*it, track));
+        used[track] = true;
+    }
+
+    for(auto& place : placement) {
+        varMap.alias(place.first, place.second);
+    }
+    return true;
+}
+
+/**
+ * Constructs the automaton of the level @p index: the automaton of its formula for the background, or the
+ * intersection of the previous level with the automaton of the conjunct.
+ *
+ * @param[in] index:    index of the level in the stack
+ */
+void IncrementalChecker::_ConstructLevel(size_t index) {
+    PROFILE_PHASE("Construction");
+    Level& level = this->_levels[index];
+
+    std::unordered_set<ASTForm*> stored;
+    if(GASTON_OPT(useDag)) {
+        for(auto it = SymbolicAutomaton::dagNodeCache->begin(); it != SymbolicAutomaton::dagNodeCache->end(); ++it) {
+            stored.insert(it->first.first);
+        }
+    }
+
+    SymbolicAutomaton* conjunct = (level.ast->formula)->toSymbolicAutomaton(false);
+    if(index == 0) {
+        level.automaton = conjunct;
+    } else {
+        level.automaton = new IntersectionAutomaton(this->_levels[index - 1].automaton, conjunct, level.form);
+    }
+    level.automaton->IncReferences();
+
+    // Nodes of the level are removed from the DAG once the level is popped
+    for(auto it = SymbolicAutomaton::dagNodeCache->begin(); it != SymbolicAutomaton::dagNodeCache->end(); ++it) {
+        if(stored.find(it->first.first) == stored.end()) {
+            level.dagKeys.push_back(it->first);
+        }
+    }
+}
+
+/**
+ * Releases the topmost level: its automaton (the shared ones stay referenced by the lower levels), its formula
+ * and everything it declared.
+ */
+void IncrementalChecker::_ReleaseLevel() {
+    assert(!this->_levels.empty());
+    Level& level = this->_levels.back();
+
+    for(auto& key : level.dagKeys) {
+        SymbolicAutomaton::dagNodeCache->erase(key);
+    }
+    if(level.automaton != nullptr) {
+        level.automaton->DecReferences();
+    }
+    if(level.form != level.ast->formula) {
+        // The conjunction only links the formulae of the levels
+        ASTForm_And* conjunction = static_cast<ASTForm_And*>(level.form);
+        conjunction->f1 = nullptr;
+        conjunction->f2 = nullptr;
+        delete conjunction;
+    }
+    delete level.ast;
+
+    // Codes of the shared table may refer the variables of the level
+    releaseMonaCodes();
+    releaseFiles(level.firstFile);
+    predicateLib.release(level.firstIdent);
+    symbolTable.release(level.firstIdent);
+    this->_levels.pop_back();
+}
+
+/**
+ * Releases all of the levels together with the state shared by their automata
+ */
+void IncrementalChecker::_ReleaseAll() {
+    while(!this->_levels.empty()) {
+        this->_ReleaseLevel();
+    }
+    SymbolicAutomaton::dagNodeCache->clear();
+    Workshops::SymbolWorkshop::ReleaseZeroSymbol();
+    Workshops::TermWorkshop::ReleaseEmpty();
+    Workshops::TermWorkshop::ResetGarbageCounters();
+}
+
+/**
+ * Loads the levels from the @p files (the first one is the background), computes the layout of tracks for their
+ * conjunction and constructs the automata of the levels.
+ *
+ * @param[in] files:    files of the levels
+ */
+void IncrementalChecker::_Build(const std::vector<std::string>& files) {
+    assert(this->_levels.empty());
+    for(size_t i = 0; i < files.size(); ++i) {
+        this->_levels.push_back(this->_LoadLevel(files[i], i == 0));
+        Level& level = this->_levels.back();
+        level.form = (i == 0) ? level.ast->formula : new ASTForm_And(this->_levels[i - 1].form, level.ast->formula, Pos());
+    }
+
+    varMap.clear();
+    initializeVarMap(this->_levels.back().form);
+    for(size_t i = 0; i < this->_levels.size(); ++i) {
+        this->_ConstructLevel(i);
+    }
+}
+
+/**
+ * Starts new session with the background formula from @p fileName, all of the conjuncts are popped
+ *
+ * @param[in] fileName:     file with the background formula
+ */
+void IncrementalChecker::Assert(const char* fileName) {
+    PROFILE_PHASE("Assert");
+    if(this->_automaton != nullptr) {
+        this->_ReleaseAutomaton();
+    }
+    this->_ReleaseAll();
+    this->_Build(std::vector<std::string>(1, fileName));
+}
+
+/**
+ * Pushes the conjunct from @p fileName. If the conjunct fits the current layout of tracks, only its automaton and
+ * the intersection with the previous level are constructed. Otherwise (it has new free variables, or there is not
+ * enough tracks for its bound variables) all of the levels are rebuilt for the extended layout.
+ *
+ * @param[in] fileName:     file with the conjunct
+ */
+void IncrementalChecker::Push(const char* fileName) {
+    assert(!this->_levels.empty() && "Background formula was not asserted");
+    PROFILE_PHASE("Push");
+    if(this->_automaton != nullptr) {
+        this->_ReleaseAutomaton();
+    }
+
+    this->_levels.push_back(this->_LoadLevel(fileName, false));
+    Level& level = this->_levels.back();
+    level.form = new ASTForm_And(this->_levels[this->_levels.size() - 2].form, level.ast->formula, Pos());
+
+    if(this->_PlaceVariables(level.ast->formula)) {
+        this->_ConstructLevel(this->_levels.size() - 1);
+    } else {
+        std::vector<std::string> files;
+        for(auto& l : this->_levels) {
+            files.push_back(l.fileName);
+        }
+        this->_ReleaseAll();
+        this->_Build(files);
+        ++this->_rebuilds;
+    }
+}
+
+/**
+ * Pops the last pushed conjunct
+ */
+void IncrementalChecker::Pop() {
+    assert(this->_levels.size() > 1 && "There is no conjunct to pop");
+    if(this->_automaton != nullptr) {
+        this->_ReleaseAutomaton();
+    }
+    this->_ReleaseLevel();
+}
+
+/**
+ * Constructs the root of the automaton for the conjunction of all of the levels. Formulae with free variables
+ * are decided by the backward search implemented in the RootProjection.
+ */
+void IncrementalChecker::ConstructAutomaton() {
+    assert(!this->_levels.empty() && "Background formula was not asserted");
+    if(this->_automaton != nullptr) {
+        this->_ReleaseAutomaton();
+    }
+    Term::SelectOptimizations();
+
+    Level& top = this->_levels.back();
+    IdentList freeVars, bound;
+    (top.form)->freeVars(&freeVars, &bound);
+    this->_isGround = freeVars.empty();
+    if(this->_isGround) {
+        this->_automaton = top.automaton;
+    } else {
+        this->_rootForm = new ASTForm_Ex1(nullptr, freeVars.copy(), top.form, Pos());
+        this->_automaton = new RootProjectionAutomaton(top.automaton, this->_rootForm);
+    }
+    this->_automaton->IncReferences();
+
+    unsigned int automata_nodes = this->_automatonNodes = this->_automaton->CountNodes();
+    std::cout << "[!] Constructed automaton with " << automata_nodes << " node" << (automata_nodes == 1 ? "" : "s") << "\n";
+}
+
+/**
+ * Releases the root of the automaton, the automata of the levels stay alive
+ */
+void IncrementalChecker::_ReleaseAutomaton() {
+    this->_automaton->DecReferences();
+    this->_automaton = nullptr;
+    if(this->_rootForm != nullptr) {
+        this->_rootForm->f = nullptr;
+        delete this->_rootForm;
+        this->_rootForm = nullptr;
+    }
+}
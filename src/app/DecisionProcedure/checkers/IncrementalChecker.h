@@ -0,0 +1,68 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: IncrementalChecker.h
+ *  Description:
+ *      Incremental deciding of the conjunction of the background formula
+ *      and the stack of conjuncts. Each level of the stack keeps its
+ *      automaton, so pushing a conjunct constructs only the automaton of
+ *      the conjunct and the intersection with the previous level; the
+ *      automata of the lower levels (and their caches) are reused.
+ *****************************************************************************/
+
+#ifndef WSKS_INCREMENTALCHECKER_H
+#define WSKS_INCREMENTALCHECKER_H
+
+#include <string>
+#include <vector>
+#include "SymbolicChecker.h"
+#include "../../Frontend/env.h"
+
+class IncrementalChecker : public SymbolicChecker {
+public:
+    // <<< PUBLIC CONSTRUCTORS AND DESTRUCTORS >>>
+    IncrementalChecker();
+    ~IncrementalChecker();
+
+    // <<< PUBLIC API >>>
+    void Assert(const char* fileName);
+    void Push(const char* fileName);
+    void Pop();
+    void ConstructAutomaton();
+    size_t Depth() const { return this->_levels.empty() ? 0 : this->_levels.size() - 1; }
+    size_t Rebuilds() const { return this->_rebuilds; }
+
+protected:
+    struct Level {
+        std::string fileName;
+        MonaAST* ast = nullptr;                 // << Parsed and preprocessed formula of the level
+        ASTForm* form = nullptr;                // << Conjunction of the formulae up to this level
+        SymbolicAutomaton* automaton = nullptr; // << Automaton for the form, referenced by the checker
+        Ident firstIdent = 0;
+        unsigned firstFile = 0;
+        std::vector<Gaston::DagKey> dagKeys;    // << Nodes of the level stored in the DAG
+    };
+
+    // <<< PRIVATE MEMBERS >>>
+    std::vector<Level> _levels;
+    ASTForm_Ex1* _rootForm;
+    Options _initialOptions;
+    size_t _rebuilds;
+
+    // <<< PRIVATE METHODS >>>
+    Level _LoadLevel(const std::string& fileName, bool isBackground);
+    bool _PlaceVariables(ASTForm* formula);
+    void _ConstructLevel(size_t index);
+    void _ReleaseLevel();
+    void _ReleaseAll();
+    void _Build(const std::vector<std::string>& files);
+    void _ReleaseAutomaton();
+};
+
+#endif //WSKS_INCREMENTALCHECKER_H
@@ -2,11 +2,14 @@
 // Created by Raph on 02/02/2016.
 //
 
+#include <sstream>
 #include "SymbolicChecker.h"
 #include "../containers/Term.h"
 #include "../../Frontend/timer.h"
 #include "../../Frontend/env.h"
 #include "../environment.hh"
+#include "../automata.hh"
+#include "../utils/PhaseProfiler.h"
 
 extern Timer timer_conversion, timer_mona, timer_base, timer_automaton;
 extern Ident lastPosVar, allPosVar;
@@ -21,27 +24,37 @@ SymbolicChecker::~SymbolicChecker() {
  */
 void SymbolicChecker::ConstructAutomaton() {
     assert(this->_monaAST != nullptr);
+    PROFILE_PHASE("Construction");
+    Term::SelectOptimizations();
 
     timer_automaton.start();
-    this->_automaton = (this->_monaAST->formula)->toSymbolicAutomaton(false);
+    if(options.mode == TREE) {
+        this->_ConstructTreeAutomaton();
+    } else {
+        this->_automaton = (this->_monaAST->formula)->toSymbolicAutomaton(false);
 
-    if(allPosVar != -1) {
-        std::cout << "[*] AllPosVar predicate detected. Will use the M2L(str) decision procedure.\n";
-    }
+        if(allPosVar != -1) {
+            std::cout << "[*] AllPosVar predicate detected. Will use the M2L(str) decision procedure.\n";
+        }
 
-    // Formulae with free variable will be decided using the backward search, that is implemented in the RootProjection
-    IdentList free, bound;
-    this->_monaAST->formula->freeVars(&free, &bound);
-    if (!free.empty()) {
-        this->_monaAST->formula = new ASTForm_Ex1(nullptr, free.copy(), this->_monaAST->formula, Pos());
-        //                        ^---- this is just a placeholding Ex1, semantically it is not First Order
-        this->_automaton = new RootProjectionAutomaton(this->_automaton, this->_monaAST->formula);
-    }
+        // Formulae with free variable will be decided using the backward search, that is implemented in the RootProjection
+        IdentList free, bound;
+        this->_monaAST->formula->freeVarsCached(&free, &bound);
+        if (!free.empty()) {
+            this->_monaAST->formula = new ASTForm_Ex1(nullptr, free.copy(), this->_monaAST->formula, Pos());
+            //                        ^---- this is just a placeholding Ex1, semantically it is not First Order
+            this->_automaton = new RootProjectionAutomaton(this->_automaton, this->_monaAST->formula);
+        }
 
-    if(options.printProgress)
-        this->_automaton->DumpAutomaton();
+        // The automaton may be shared by the DAG of the later queries (see Gaston::Solver)
+        this->_automaton->IncReferences();
+
+        if(options.printProgress)
+            this->_automaton->DumpAutomaton();
+        this->_automatonNodes = this->_automaton->CountNodes();
+    }
     std::cout << "\n";
-    unsigned int automata_nodes = this->_automaton->CountNodes();
+    unsigned int automata_nodes = this->_automatonNodes;
     std::cout << "[!] Constructed automaton with " << automata_nodes << " node" << (automata_nodes == 1 ? "" : "s") << "\n";
 
     timer_automaton.stop();
@@ -53,6 +66,51 @@ void SymbolicChecker::ConstructAutomaton() {
     }
 }
 
+/**
+ * Construction of the symbolic tree automaton of the WS2S formula. Formulae with free variables are decided by the
+ * projection of the free variables from the automaton of the formula (for satisfying example) and from the automaton
+ * of its negation (for unsatisfying example).
+ */
+void SymbolicChecker::_ConstructTreeAutomaton() {
+    TreeAutomaton* automaton = toTreeAutomaton(this->_monaAST->formula);
+
+    IdentList free, bound;
+    this->_monaAST->formula->freeVarsCached(&free, &bound);
+    if(free.empty()) {
+        this->_treeAutomaton = automaton;
+    } else {
+        this->_treeAutomaton = new ProjectionTreeAutomaton(automaton, &free);
+        this->_treeCounterAutomaton = new ProjectionTreeAutomaton(new ComplementTreeAutomaton(automaton), &free);
+        this->_treeCounterAutomaton->IncReferences();
+    }
+    this->_treeAutomaton->IncReferences();
+
+    if(options.printProgress)
+        this->_treeAutomaton->DumpAutomaton();
+    this->_automatonNodes = this->_treeAutomaton->CountNodes();
+}
+
+/**
+ * Decides the WS2S formula by testing whether the initial term of the root state space is final, i.e. whether the
+ * (projected) automaton accepts some tree
+ */
+int SymbolicChecker::_DecideTree() {
+    assert(this->_treeAutomaton != nullptr);
+    std::cout << "\n[*] Deciding WS2S Symbolically\n";
+
+    bool isSatisfiable = this->_treeAutomaton->IsFinal(this->_treeAutomaton->GetInitial(0));
+    // Closed formula is valid if the automaton accepts some (hence any) tree
+    if(this->_treeCounterAutomaton == nullptr) {
+        return isSatisfiable ? Decision::VALID : Decision::UNSATISFIABLE;
+    } else if(!isSatisfiable) {
+        return Decision::UNSATISFIABLE;
+    }
+
+    assert(this->_treeCounterAutomaton != nullptr);
+    bool isFalsifiable = this->_treeCounterAutomaton->IsFinal(this->_treeCounterAutomaton->GetInitial(0));
+    return isFalsifiable ? Decision::SATISFIABLE : Decision::VALID;
+}
+
 /**
  * Core evaluation of decision procedure according to the membership testing of epsilon and/or the found (counter)
  * examples during the backward search
@@ -89,19 +147,23 @@ int SymbolicChecker::_DecideCore(bool isValid) {
  * core function. Moreover prints various timings.
  */
 void SymbolicChecker::Decide() {
-    assert(this->_automaton != nullptr);
+    assert(this->_automaton != nullptr || this->_treeAutomaton != nullptr);
 
     try {
         Timer timer_deciding;
-        bool decided;
-        // Deciding WS1S formula
+        int decision;
+        // Deciding WS1S (or WS2S) formula
         timer_deciding.start();
-        decided = this->Run();
+        {
+            PROFILE_PHASE("Deciding");
+            decision = (this->_treeAutomaton != nullptr) ? this->_DecideTree() : this->_DecideCore(this->Run());
+        }
         timer_deciding.stop();
 
         // Outing the results of decision procedure
         std::cout << "[!] Formula is ";
-        switch(this->_DecideCore(decided)) {
+        this->_decision = static_cast<Decision>(decision);
+        switch(this->_decision) {
             case Decision::SATISFIABLE:
                 std::cout << "\033[1;34m'SATISFIABLE'\033[0m";
                 break;
@@ -126,13 +188,49 @@ void SymbolicChecker::Decide() {
         timer_automaton.print();
         // Something that was used is not supported by dWiNA
 
-        delete this->_automaton;
-        this->_automaton = nullptr;
+        this->_RecordExamples();
+        this->_ReleaseAutomaton();
     } catch (NotImplementedException& e) {
         std::cerr << e.what() << std::endl;
     }
 }
 
+/**
+ * Stores the satisfying and unsatisfying examples found by the backward search, if the recording was requested.
+ * Examples are kept only by the root projection, i.e. for the formulae with free variables.
+ */
+void SymbolicChecker::_RecordExamples() {
+    this->_examples[ExampleType::SATISFYING].clear();
+    this->_examples[ExampleType::UNSATISFYING].clear();
+    if(!this->_recordExamples || this->_automaton == nullptr || this->_automaton->type != AutType::PROJECTION)
+        return;
+
+    std::streambuf* stdoutBuffer = std::cout.rdbuf();
+    for(ExampleType e : {ExampleType::SATISFYING, ExampleType::UNSATISFYING}) {
+        std::ostringstream example;
+        std::cout.rdbuf(example.rdbuf());
+        this->_automaton->DumpExample(e);
+        this->_examples[e] = example.str();
+    }
+    std::cout.rdbuf(stdoutBuffer);
+}
+
+/**
+ * Releases the automaton after it was decided
+ */
+void SymbolicChecker::_ReleaseAutomaton() {
+    if(this->_automaton != nullptr) {
+        this->_automaton->DecReferences();
+        this->_automaton = nullptr;
+    }
+    for(TreeAutomaton** automaton : {&this->_treeAutomaton, &this->_treeCounterAutomaton}) {
+        if(*automaton != nullptr) {
+            (*automaton)->DecReferences();
+            *automaton = nullptr;
+        }
+    }
+}
+
 /**
  * Runs the decision procedure on the constructed automaton
  */
@@ -5,23 +5,38 @@
 #ifndef WSKS_SYMBOLICCHECKER_H
 #define WSKS_SYMBOLICCHECKER_H
 
+#include <string>
 #include "Checker.h"
 #include "../containers/SymbolicAutomata.h"
+#include "../containers/TreeAutomata.h"
 
 class SymbolicChecker : public Checker {
 public:
     // <<< PUBLIC CONSTRUCTORS >>>
-    SymbolicChecker() : _automaton(nullptr), Checker() {}
+    SymbolicChecker() : _automaton(nullptr), _treeAutomaton(nullptr), _treeCounterAutomaton(nullptr), _automatonNodes(0),
+        _recordExamples(false), Checker() {}
     ~SymbolicChecker();
 
     void ConstructAutomaton();
     void Decide();
     bool Run();
+    void RecordExamples(bool record) { this->_recordExamples = record; }
+    const std::string& GetExample(ExampleType e) const { return this->_examples[e]; }
+    unsigned int GetNodeCount() const { return this->_automatonNodes; }
 protected:
     SymbolicAutomaton* _automaton;
+    TreeAutomaton* _treeAutomaton;            // << Automaton of the WS2S formula (projected on the free variables)
+    TreeAutomaton* _treeCounterAutomaton;     // << Automaton of its negation (for formulae with free variables only)
+    unsigned int _automatonNodes;
+    bool _recordExamples;
+    std::string _examples[2];   // << Satisfying and unsatisfying example, if recorded
 
     // <<< PRIVATE METHODS >>>
+    void _RecordExamples();
     int _DecideCore(bool);
+    void _ConstructTreeAutomaton();
+    int _DecideTree();
+    virtual void _ReleaseAutomaton();
 };
 
 
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: BaseSimulation.cpp
+ *  Description:
+ *      Maximal backward simulation over the states of the base automaton.
+ *      Since the terms are computed backwards from the final states, the
+ *      state q is simulated by the state r, if every backward run from q
+ *      to the initial state can be mimicked by the backward run from r.
+ *      Sets of base states are then compared modulo the simulation.
+ *****************************************************************************/
+
+#include "BaseSimulation.h"
+
+/**
+ * Stores the simulation @p relation, where relation.get(q, r) means that q is simulated by r, as the rows of
+ * simulating states for faster lookups.
+ *
+ * @param[in] relation:     computed simulation relation
+ * @param[in] stateNo:      number of states of the automaton
+ */
+void BaseSimulation::Initialize(const VATA::Util::BinaryRelation& relation, size_t stateNo) {
+    this->_simulators.assign(stateNo, boost::dynamic_bitset<>(stateNo));
+    this->_nontrivialPairs = 0;
+
+    for(size_t q = 0; q < stateNo; ++q) {
+        this->_simulators[q].set(q);
+        for(size_t r = 0; r < stateNo; ++r) {
+            if(q != r && relation.get(q, r)) {
+                this->_simulators[q].set(r);
+                ++this->_nontrivialPairs;
+            }
+        }
+    }
+}
+
+/**
+ * Tests whether each state of @p smaller is simulated by some state of @p bigger. This generalizes the inclusion
+ * of sets of states, since the simulation is reflexive.
+ *
+ * @param[in] smaller:      set of states that should be covered
+ * @param[in] smallerSize:  number of states of @p smaller
+ * @param[in] bigger:       set of states that covers
+ * @param[in] biggerSize:   number of states of @p bigger
+ * @return:                 true if every state of @p smaller is simulated by state from @p bigger
+ */
+bool BaseSimulation::IsCovered(const size_t* smaller, size_t smallerSize, const size_t* bigger, size_t biggerSize) const {
+    if(this->_simulators.empty()) {
+        return false;
+    }
+
+    boost::dynamic_bitset<> biggerSet(this->_simulators.size());
+    for(const size_t* state = bigger; state != bigger + biggerSize; ++state) {
+        if(*state < biggerSet.size()) {
+            biggerSet.set(*state);
+        }
+    }
+
+    for(const size_t* state = smaller; state != smaller + smallerSize; ++state) {
+        if(*state >= this->_simulators.size() || !this->_simulators[*state].intersects(biggerSet)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,40 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: BaseSimulation.h
+ *  Description:
+ *      Maximal backward simulation over the states of the base automaton.
+ *      Since the terms are computed backwards from the final states, the
+ *      state q is simulated by the state r, if every backward run from q
+ *      to the initial state can be mimicked by the backward run from r.
+ *      Sets of base states are then compared modulo the simulation.
+ *****************************************************************************/
+
+#ifndef WSKS_BASESIMULATION_H
+#define WSKS_BASESIMULATION_H
+
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+#include <vata/util/binary_relation.hh>
+
+class BaseSimulation {
+private:
+    // <<< PRIVATE MEMBERS >>>
+    std::vector<boost::dynamic_bitset<>> _simulators;   // < For each state the states that simulate it
+    size_t _nontrivialPairs = 0;                        // < Number of pairs (q, r) with q != r in simulation
+
+public:
+    // <<< PUBLIC API >>>
+    void Initialize(const VATA::Util::BinaryRelation& relation, size_t stateNo);
+    bool IsTrivial() const { return this->_nontrivialPairs == 0; }
+    size_t NontrivialPairs() const { return this->_nontrivialPairs; }
+    bool IsCovered(const size_t* smaller, size_t smallerSize, const size_t* bigger, size_t biggerSize) const;
+};
+
+#endif //WSKS_BASESIMULATION_H
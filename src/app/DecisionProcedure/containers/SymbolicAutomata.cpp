@@ -13,6 +13,7 @@
  *      done on this representation according to the latest paper.
  *****************************************************************************/
 
+#include <algorithm>
 #include <list>
 #include <stdint.h>
 #include "SymbolicAutomata.h"
@@ -20,6 +21,7 @@
 #include "../environment.hh"
 #include "../containers/VarToTrackMap.hh"
 #include "../containers/Workshops.h"
+#include "../utils/VarSet.h"
 #include "../../Frontend/dfa.h"
 #include "../../Frontend/symboltable.h"
 #include "../../Frontend/timer.h"
@@ -34,10 +36,13 @@ DagNodeCache* SymbolicAutomaton::dagNodeCache = new DagNodeCache();
 using namespace Gaston;
 
 // <<< SYMLINK FUNCTIONS >>>
+size_t SymLink::remapCounter = 0;
+
 void SymLink::InitializeSymLink(ASTForm* form) {
     if(this->aut->_form != form) {
         // Construct the mapping
         this->varRemap = new std::map<unsigned int, unsigned int>();
+        this->remapId = ++SymLink::remapCounter;
         this->remap = true;
         form->ConstructMapping(this->aut->_form, *this->varRemap);
 #       if (DEBUG_DAG_REMAPPING == true)
@@ -51,7 +56,7 @@ void SymLink::InitializeSymLink(ASTForm* form) {
 
 ZeroSymbol* SymLink::ReMapSymbol(ZeroSymbol* symbol) {
     if(this->remap && symbol != nullptr) {
-        return this->aut->symbolFactory->CreateRemappedSymbol(symbol, this->varRemap);
+        return this->aut->symbolFactory->CreateRemappedSymbol(symbol, this->varRemap, this->remapId);
     } else {
         return symbol;
     }
@@ -65,17 +70,13 @@ SymbolicAutomaton::SymbolicAutomaton(Formula_ptr form) :
 
     this->symbolFactory = new Workshops::SymbolWorkshop();
     IdentList free, bound;
-    this->_form->freeVars(&free, &bound);
-    IdentList* allVars;
-    allVars = ident_union(&free, &bound);
-    if(allVars != nullptr) {
-        for(auto it = allVars->begin(); it != allVars->end(); ++it) {
-            if(varMap.IsIn(*it))
-                _freeVars.insert(varMap[(*it)]);
-        }
-
-        delete allVars;
-    }
+    this->_form->freeVarsCached(&free, &bound);
+    VarSet allVars(&free);
+    allVars.Insert(&bound);
+    allVars.ForEach([this](Ident var) {
+        if(varMap.IsIn(var))
+            this->_freeVars.insert(varMap[var]);
+    });
 }
 
 SymbolicAutomaton::~SymbolicAutomaton() {
@@ -126,6 +127,9 @@ RootProjectionAutomaton::RootProjectionAutomaton(SymbolicAutomaton* aut, Formula
 
 BaseAutomaton::BaseAutomaton(BaseAutomatonType* aut, size_t vars, Formula_ptr form, bool emptyTracks) : SymbolicAutomaton(form), _autWrapper(dfaCopy(aut), emptyTracks, vars) {
     type = AutType::BASE;
+    if(GASTON_OPT(simulationSubsumption)) {
+        this->_InitializeSimulation();
+    }
     this->_InitializeAutomaton();
     this->_stateSpace = vars;
 }
@@ -180,6 +184,62 @@ UnionAutomaton::UnionAutomaton(SymbolicAutomaton_raw lhs, SymbolicAutomaton_raw
     this->_InitializeAutomaton();
 }
 
+NaryOpAutomaton::NaryOpAutomaton(std::vector<std::pair<SymbolicAutomaton_raw, Formula_ptr>>& operands, Formula_ptr form)
+        : SymbolicAutomaton(form), _decisions(operands.size(), 0) {
+    assert(operands.size() > 1);
+    type = AutType::BINARY;
+    for(size_t i = 0; i < operands.size(); ++i) {
+        SymLink* link = new SymLink(operands[i].first);
+        operands[i].first->IncReferences();
+        link->InitializeSymLink(operands[i].second);
+        this->_auts.push_back(link);
+        this->_order.push_back(i);
+    }
+}
+
+NaryOpAutomaton::~NaryOpAutomaton() {
+    for(SymLink* link : this->_auts) {
+        link->aut->DecReferences();
+        delete link;
+    }
+}
+
+NaryIntersectionAutomaton::NaryIntersectionAutomaton(std::vector<std::pair<SymbolicAutomaton_raw, Formula_ptr>>& operands, Formula_ptr form)
+        : NaryOpAutomaton(operands, form) {
+    this->type = AutType::INTERSECTION;
+    this->_productType = E_INTERSECTION;
+    this->_eval_result = [](bool a, bool b, bool underC) {
+        if(!underC) {return a && b;}
+        else {return a || b;}
+    };
+    this->_eval_early = [](bool a, bool underC) {
+        return (a == underC);
+    };
+    this->_early_val = [](bool underC) {
+        return underC;
+    };
+
+    this->_InitializeAutomaton();
+}
+
+NaryUnionAutomaton::NaryUnionAutomaton(std::vector<std::pair<SymbolicAutomaton_raw, Formula_ptr>>& operands, Formula_ptr form)
+        : NaryOpAutomaton(operands, form) {
+    this->type = AutType::UNION;
+    this->_productType = E_UNION;
+    this->_eval_result = [](bool a, bool b, bool underC) {
+        if(!underC) {return a || b;}
+        else { return a && b;}
+    };
+    this->_eval_early = [](bool a, bool underC) {
+        return (a != underC);
+    };
+    this->_early_val = [](bool underC) {
+        return !underC;
+    };
+
+    this->_InitializeAutomaton();
+}
+
 /**
  * @param[in] symbol:               symbol we are minusing away
  * @param[in] stateApproximation:   approximation of final states
@@ -247,7 +307,10 @@ ResultType SymbolicAutomaton::IntersectNonEmpty(Symbol* symbol, Term* stateAppro
 #   endif
 
     // Call the core function
-    result = this->_IntersectNonEmptyCore(symbol, stateApproximation, underComplement); // TODO: Memory consumption
+    {
+        TRACE_SPAN("IntersectNonEmpty", this, this->type);
+        result = this->_IntersectNonEmptyCore(symbol, stateApproximation, underComplement); // TODO: Memory consumption
+    }
 #   if (MEASURE_RESULT_HITS == true || MEASURE_ALL == true)
     (result.second ? ++this->_trueCounter : ++this->_falseCounter);
 #   endif
@@ -300,6 +363,7 @@ ResultType SymbolicAutomaton::IntersectNonEmpty(Symbol* symbol, Term* stateAppro
 
 ResultType RootProjectionAutomaton::IntersectNonEmpty(Symbol* symbol, Term* finalApproximation, bool underComplement) {
     assert(this->_unsatExample == nullptr && this->_satExample == nullptr);
+    TRACE_SPAN("RootIntersectNonEmpty", this, this->type);
 
     // We are doing the initial step by evaluating the epsilon
     TermList* projectionApproximation = reinterpret_cast<TermList*>(finalApproximation);
@@ -370,6 +434,12 @@ ResultType RootProjectionAutomaton::IntersectNonEmpty(Symbol* symbol, Term* fina
             std::cout << "[*] Found unsatisfying counter-example\n";
             this->_unsatExample = examples.second;
         }
+
+        // Between the iterations the terms are held only by the fixpoint, automata and their caches
+        if(GASTON_OPT(collectTerms) && Workshops::TermWorkshop::ShouldCollectGarbage()) {
+            std::vector<Term*> roots = {fixpoint, fixpointTerm, result.first, finalApproximation};
+            Workshops::TermWorkshop::CollectGarbage(roots);
+        }
     }
 #   if (DEBUG_EXAMPLE_PATHS == true)
     timer_paths.stop();
@@ -441,6 +511,12 @@ void BinaryOpAutomaton::_InitializeAutomaton() {
     this->_InitializeFinalStates();
 }
 
+void NaryOpAutomaton::_InitializeAutomaton() {
+    this->_factory.InitializeWorkshop();
+    this->_InitializeInitialStates();
+    this->_InitializeFinalStates();
+}
+
 void ComplementAutomaton::_InitializeAutomaton() {
     this->_factory.InitializeWorkshop();
     this->_InitializeInitialStates();
@@ -466,6 +542,14 @@ void BinaryOpAutomaton::_InitializeInitialStates() {
     #endif
 }
 
+void NaryOpAutomaton::_InitializeInitialStates() {
+    std::vector<Term_ptr> operands;
+    for(SymLink* link : this->_auts) {
+        operands.push_back(link->aut->GetInitialStates());
+    }
+    this->_initialStates = this->_CreateProductChain(operands);
+}
+
 void ComplementAutomaton::_InitializeInitialStates() {
     this->_initialStates = this->_aut.aut->GetInitialStates();
 }
@@ -485,7 +569,7 @@ void BaseAutomaton::_InitializeInitialStates() {
     BaseAutomatonStateSet initialStates;
     initialStates.insert(this->_autWrapper.GetInitialState());
 
-    this->_initialStates = this->_factory.CreateBaseSet(initialStates, this->_stateOffset, this->_stateSpace);
+    this->_initialStates = this->_factory.CreateBaseSet(initialStates, this->_stateOffset, this->_stateSpace, this->_GetSimulation());
 }
 
 /**
@@ -500,6 +584,60 @@ void BinaryOpAutomaton::_InitializeFinalStates() {
     #endif
 }
 
+void NaryOpAutomaton::_InitializeFinalStates() {
+    std::vector<Term_ptr> operands;
+    for(SymLink* link : this->_auts) {
+        operands.push_back(link->aut->GetFinalStates());
+    }
+    this->_finalStates = this->_CreateProductChain(operands);
+}
+
+/**
+ * Creates the term of the n-ary product: right-leaning chain of products of the @p operands
+ *
+ * @param[in] operands:     terms of the operands, in the order of operands
+ * @return:                 product (t_1, (t_2, ... (t_n-1, t_n)))
+ */
+Term_ptr NaryOpAutomaton::_CreateProductChain(std::vector<Term_ptr>& operands) {
+    assert(operands.size() == this->_auts.size());
+    Term_ptr chain = operands.back();
+    for(size_t i = operands.size() - 1; i > 0; --i) {
+        // #TERM_CREATION
+#       if (DEBUG_NO_WORKSHOPS == true)
+        chain = new TermProduct(operands[i - 1], chain, this->_productType);
+#       else
+        chain = this->_factory.CreateProduct(operands[i - 1], chain, this->_productType);
+#       endif
+    }
+    return chain;
+}
+
+/**
+ * Splits the term of the n-ary product to the terms of the operands
+ *
+ * @param[in] chain:        term created by _CreateProductChain
+ * @param[out] operands:    terms of the operands, in the order of operands
+ */
+void NaryOpAutomaton::_SplitProductChain(Term_ptr chain, std::vector<Term_ptr>& operands) {
+    for(size_t i = 0; i + 1 < this->_auts.size(); ++i) {
+        assert(chain->type == TERM_PRODUCT);
+        TermProduct* product = reinterpret_cast<TermProduct*>(chain);
+        operands.push_back(product->left);
+        chain = product->right;
+    }
+    operands.push_back(chain);
+}
+
+/**
+ * Sorts the operands by the number of times they decided the result, so the deciding ones are evaluated first
+ */
+void NaryOpAutomaton::_ReorderOperands() {
+    std::vector<unsigned int>& decisions = this->_decisions;
+    std::stable_sort(this->_order.begin(), this->_order.end(), [&decisions](size_t lhs, size_t rhs) {
+        return decisions[lhs] > decisions[rhs];
+    });
+}
+
 void ComplementAutomaton::_InitializeFinalStates() {
     this->_finalStates = this->_aut.aut->GetFinalStates();
     assert(this->_finalStates->type != TERM_EMPTY);
@@ -524,7 +662,43 @@ void BaseAutomaton::_InitializeFinalStates() {
 
     // Push states to new Base Set
     // #TERM_CREATION
-    this->_finalStates = reinterpret_cast<Term*>(this->_factory.CreateBaseSet(finalStates, this->_stateOffset, this->_stateSpace));
+    this->_finalStates = reinterpret_cast<Term*>(this->_factory.CreateBaseSet(finalStates, this->_stateOffset, this->_stateSpace, this->_GetSimulation()));
+}
+
+/**
+ * Computes the maximal backward simulation of the base automaton. The transitions of the automaton are reversed,
+ * since the terms are computed by the pre, and the initial state can be simulated only by itself. The automata
+ * over too many variables are skipped, as the explicit alphabet would be too big.
+ */
+void BaseAutomaton::_InitializeSimulation() {
+    VATA::ExplicitLTS lts;
+    if(!this->_autWrapper.BuildReversedLTS(lts, SIMULATION_MAX_TRANSITIONS)) {
+        return;
+    }
+    lts.init();
+
+    size_t stateNo = this->_autWrapper.GetStateNo();
+    size_t initialState = this->_autWrapper.GetInitialState();
+    if(lts.states() != stateNo) {
+        return;
+    }
+
+    // The initial state is separated from others, as it cannot be simulated by any other state
+    std::vector<std::vector<size_t>> partition(2);
+    for(size_t state = 0; state < stateNo; ++state) {
+        partition[state == initialState].push_back(state);
+    }
+    VATA::Util::BinaryRelation relation(2, true);
+    relation.set(1, 0, false);
+
+    this->_simulation.Initialize(lts.computeSimulation(partition, relation, stateNo), stateNo);
+}
+
+/**
+ * @return: simulation used for subsumption of base sets or nullptr if the simulation is only identity
+ */
+BaseSimulation* BaseAutomaton::_GetSimulation() {
+    return this->_simulation.IsTrivial() ? nullptr : &this->_simulation;
 }
 
 /**
@@ -540,6 +714,10 @@ Term* BinaryOpAutomaton::Pre(Symbol* symbol, Term* finalApproximation, bool unde
     assert(false && "Doing Pre on BinaryOp Automaton!");
 }
 
+Term* NaryOpAutomaton::Pre(Symbol* symbol, Term* finalApproximation, bool underComplement) {
+    assert(false && "Doing Pre on NaryOp Automaton!");
+}
+
 Term* ComplementAutomaton::Pre(Symbol* symbol, Term* finalApproximation, bool underComplement) {
     assert(false && "Doing Pre on Complement Automaton!");
 }
@@ -550,6 +728,7 @@ Term* ProjectionAutomaton::Pre(Symbol* symbol, Term* finalApproximation, bool un
 
 Term* BaseAutomaton::Pre(Symbol* symbol, Term* finalApproximation, bool underComplement) {
     assert(symbol != nullptr);
+    TRACE_SPAN("Pre", this, this->type);
     // TODO: Implement the -minus
 
     // Reinterpret the approximation as base states
@@ -566,7 +745,9 @@ Term* BaseAutomaton::Pre(Symbol* symbol, Term* finalApproximation, bool underCom
     std::cout << (*symbol) << "\n";
     #endif
 
-    BaseAutomatonStateSet null;
+    // Pre-images of single states are collected and merged at once by multi-way union
+    std::vector<BaseAutomatonStateSet> preImages;
+    preImages.reserve(baseSet->states.size());
 
     for(auto state : baseSet->states) {
         // Get MTBDD for Pre of states @p state
@@ -577,17 +758,18 @@ Term* BaseAutomaton::Pre(Symbol* symbol, Term* finalApproximation, bool underCom
             preStates = this->_autWrapper.Pre(state, symbol->GetTrackMask());
             this->_preCache.StoreIn(key, preStates);
         }
-        states.insert(preStates);
         #if (DEBUG_PRE == true)
         std::cout << "{" << state << "} \u2212 " << (*symbol) << " = " << preStates << "\n";
         #endif
+        preImages.push_back(std::move(preStates));
     }
+    states.InsertAll(preImages.begin(), preImages.end());
 
     #if (DEBUG_PRE == true)
     std::cout << "= " << states << "\n";
     #endif
 
-    return this->_factory.CreateBaseSet(states, this->_stateOffset, this->_stateSpace);
+    return this->_factory.CreateBaseSet(states, this->_stateOffset, this->_stateSpace, this->_GetSimulation());
 }
 
 /**
@@ -613,11 +795,9 @@ ResultType BinaryOpAutomaton::_IntersectNonEmptyCore(Symbol* symbol, Term* final
 
     // We can prune the state if left side was evaluated as Empty term
     // TODO: This is different for Unionmat!
-#   if (OPT_PRUNE_EMPTY == true)
-    if(lhs_result.first->type == TERM_EMPTY && !lhs_result.first->InComplement() && this->_productType == ProductType::E_INTERSECTION) {
+    if(GASTON_OPT(pruneEmpty) && lhs_result.first->type == TERM_EMPTY && !lhs_result.first->InComplement() && this->_productType == ProductType::E_INTERSECTION) {
         return std::make_pair(lhs_result.first, underComplement);
     }
-#   endif
 
 #   if (OPT_EARLY_EVALUATION == true && MONA_FAIR_MODE == false)
     // Sometimes we can evaluate the experession early and return the continuation.
@@ -651,11 +831,9 @@ ResultType BinaryOpAutomaton::_IntersectNonEmptyCore(Symbol* symbol, Term* final
     ResultType rhs_result = this->_rhs_aut.aut->IntersectNonEmpty(this->_rhs_aut.ReMapSymbol(symbol), productStateApproximation->right, underComplement);
     // We can prune the state if right side was evaluated as Empty term
     // TODO: This is different for Unionmat!
-#   if (OPT_PRUNE_EMPTY == true)
-    if(rhs_result.first->type == TERM_EMPTY && !rhs_result.first->InComplement() && this->_productType == ProductType::E_INTERSECTION) {
+    if(GASTON_OPT(pruneEmpty) && rhs_result.first->type == TERM_EMPTY && !rhs_result.first->InComplement() && this->_productType == ProductType::E_INTERSECTION) {
         return std::make_pair(rhs_result.first, underComplement);
     }
-#   endif
 
     // TODO: #TERM_CREATION
 #   if (DEBUG_NO_WORKSHOPS == true)
@@ -666,6 +844,75 @@ ResultType BinaryOpAutomaton::_IntersectNonEmptyCore(Symbol* symbol, Term* final
     return std::make_pair(combined, this->_eval_result(lhs_result.second, rhs_result.second, underComplement));
 }
 
+/**
+ * Tests if Initial states intersects the Final states of the n-ary product. The operands are evaluated in the order
+ * given by _order, and the evaluation stops at the first operand that decides the result: for intersection when the
+ * operand term is empty, or (with early evaluation) when the accumulated result is decided, in which case the rest
+ * of the operands is postponed as continuations.
+ *
+ * @param[in] symbol:               symbol we are minusing away
+ * @param[in] finalApproximation:   approximation of states that were computed above
+ * @param[in] underComplement:      true, if we are computing interesction under complement
+ * @return (fixpoint, bool)
+ */
+ResultType NaryOpAutomaton::_IntersectNonEmptyCore(Symbol* symbol, Term* finalApproximation, bool underComplement) {
+    assert(finalApproximation != nullptr);
+    assert(finalApproximation->type == TERM_PRODUCT);
+
+    std::vector<Term_ptr> approximations;
+    approximations.reserve(this->_auts.size());
+    this->_SplitProductChain(finalApproximation, approximations);
+    std::vector<Term_ptr> results(this->_auts.size(), nullptr);
+
+    // The order is refreshed with exponentially decreasing frequency
+    ++this->_evaluations;
+    if((this->_evaluations & (this->_evaluations - 1)) == 0) {
+        this->_ReorderOperands();
+    }
+
+#   if (OPT_EARLY_EVALUATION == true && MONA_FAIR_MODE == false)
+#   if (OPT_CONT_ONLY_WHILE_UNSAT == true)
+    // Continuations are generated only until the product is evaluated as true (false for union)
+    bool canGenerateContinuations = (this->_productType == ProductType::E_INTERSECTION ?
+                                     (this->_trueCounter == 0) : (this->_falseCounter == 0));
+#   else
+    bool canGenerateContinuations = true;
+#   endif
+#   endif
+
+    bool result = false;
+    for(size_t k = 0; k < this->_order.size(); ++k) {
+        size_t i = this->_order[k];
+        SymLink* link = this->_auts[i];
+        ResultType operandResult = link->aut->IntersectNonEmpty(link->ReMapSymbol(symbol), approximations[i], underComplement);
+        results[i] = operandResult.first;
+
+        // We can prune the state if the operand was evaluated as Empty term
+        if(GASTON_OPT(pruneEmpty) && operandResult.first->type == TERM_EMPTY && !operandResult.first->InComplement() && this->_productType == ProductType::E_INTERSECTION) {
+            ++this->_decisions[i];
+            return std::make_pair(operandResult.first, underComplement);
+        }
+        result = (k == 0 ? operandResult.second : this->_eval_result(result, operandResult.second, underComplement));
+
+#       if (OPT_EARLY_EVALUATION == true && MONA_FAIR_MODE == false)
+        if(canGenerateContinuations && k + 1 < this->_order.size() && this->_eval_early(result, underComplement)) {
+            ++this->_decisions[i];
+#           if (MEASURE_CONTINUATION_CREATION == true || MEASURE_ALL == true)
+            ++this->_contCreationCounter;
+#           endif
+            for(size_t j = k + 1; j < this->_order.size(); ++j) {
+                size_t postponed = this->_order[j];
+                SymLink* postponedLink = this->_auts[postponed];
+                results[postponed] = this->_factory.CreateContinuation(postponedLink->aut, approximations[postponed], postponedLink->ReMapSymbol(symbol), underComplement);
+            }
+            return std::make_pair(this->_CreateProductChain(results), this->_early_val(underComplement));
+        }
+#       endif
+    }
+
+    return std::make_pair(this->_CreateProductChain(results), result);
+}
+
 ResultType ComplementAutomaton::_IntersectNonEmptyCore(Symbol* symbol, Term* finalApproximaton, bool underComplement) {
     // Compute the result of nested automaton with switched complement
     ResultType result = this->_aut.aut->IntersectNonEmpty(this->_aut.ReMapSymbol(symbol), finalApproximaton, !underComplement);
@@ -718,18 +965,18 @@ ResultType ProjectionAutomaton::_IntersectNonEmptyCore(Symbol* symbol, Term* fin
 #       if (OPT_NO_SATURATION_FOR_M2L == true)
         // We will not saturate the fixpoint computation when computing the M2L(str) logic
         if(allPosVar != -1) {
-#           if (OPT_REDUCE_FULL_FIXPOINT == true)
-            fixpoint->RemoveSubsumed();
-#           endif
+            if(GASTON_OPT(reduceFullFixpoint)) {
+                fixpoint->RemoveSubsumed();
+            }
             return std::make_pair(fixpoint, result.second);
         }
 #       endif
 
         // Early evaluation of fixpoint
         if(result.second == !underComplement) {
-            #if (OPT_REDUCE_FULL_FIXPOINT == true)
-            fixpoint->RemoveSubsumed();
-            #endif
+            if(GASTON_OPT(reduceFullFixpoint)) {
+                fixpoint->RemoveSubsumed();
+            }
             return std::make_pair(fixpoint, result.second);
         }
 
@@ -743,9 +990,9 @@ ResultType ProjectionAutomaton::_IntersectNonEmptyCore(Symbol* symbol, Term* fin
         #endif
 
         // Return (fixpoint, bool)
-        #if (OPT_REDUCE_FULL_FIXPOINT == true)
-        fixpoint->RemoveSubsumed();
-        #endif
+        if(GASTON_OPT(reduceFullFixpoint)) {
+            fixpoint->RemoveSubsumed();
+        }
         return std::make_pair(fixpoint, fixpoint->GetResult());
     } else {
         // Create a new fixpoint term and iterator on it
@@ -773,9 +1020,9 @@ ResultType ProjectionAutomaton::_IntersectNonEmptyCore(Symbol* symbol, Term* fin
         #endif
 
         // TODO: Fixpoint cache should probably be here!
-        #if (OPT_REDUCE_PREFIXPOINT == true)
-        fixpoint->RemoveSubsumed();
-        #endif
+        if(GASTON_OPT(reducePrefixpoint)) {
+            fixpoint->RemoveSubsumed();
+        }
         #if (OPT_GENERATE_UNIQUE_TERMS == true && UNIQUE_FIXPOINTS == true)
         fixpoint = this->_factory.GetUniqueFixpoint(fixpoint);
         #endif
@@ -828,6 +1075,10 @@ void BinaryOpAutomaton::_DumpExampleCore(ExampleType e) {
     assert(false && "BinaryOpAutomata cannot have examples yet!");
 }
 
+void NaryOpAutomaton::_DumpExampleCore(ExampleType e) {
+    assert(false && "NaryOpAutomata cannot have examples yet!");
+}
+
 void ComplementAutomaton::_DumpExampleCore(ExampleType e) {
     assert(false && "ComplementAutomata cannot have examples yet!");
 }
@@ -917,6 +1168,21 @@ void BinaryOpAutomaton::DumpAutomaton() {
     std::cout << ")\033[0m";
 }
 
+void NaryOpAutomaton::DumpAutomaton() {
+    #if (DEBUG_AUTOMATA_ADDRESSES == true)
+        std::cout << "[" << this << "]";
+    #endif
+    const char* color = (this->type == AutType::INTERSECTION ? "\033[1;32m" : "\033[1;33m");
+    std::cout << color << "(\033[0m";
+    for(size_t i = 0; i < this->_auts.size(); ++i) {
+        if(i != 0) {
+            std::cout << color << (this->type == AutType::INTERSECTION ? " \u2229 " : " \u222A ") << "\033[0m";
+        }
+        this->_auts[i]->aut->DumpAutomaton();
+    }
+    std::cout << color << ")\033[0m";
+}
+
 void ComplementAutomaton::DumpAutomaton() {
     #if (DEBUG_AUTOMATA_ADDRESSES == true)
         std::cout << "[" << this << "]";
@@ -1073,6 +1339,27 @@ void BinaryOpAutomaton::DumpToDot(std::ofstream & os, bool inComplement) {
     this->_rhs_aut.aut->DumpToDot(os, inComplement);
 }
 
+void NaryOpAutomaton::DumpToDot(std::ofstream & os, bool inComplement) {
+    os << "\t" << (uintptr_t) &*this << "[label=\"";
+    os << "\u03B5 " << (inComplement ? "\u2209 " : "\u2208 ");
+    if(this->_productType == ProductType::E_INTERSECTION) {
+        os << "\u22C2";
+    } else {
+        os << "\u22C3";
+    }
+    os << "\\n(" << this->_trueCounter << "\u22A8, " << this->_falseCounter << "\u22AD)\"";
+    if(this->_trueCounter == 0 && this->_falseCounter != 0) {
+        os << ",style=filled, fillcolor=red";
+    }
+    os << "];\n";
+    for(SymLink* link : this->_auts) {
+        os << "\t" << (uintptr_t) &*this << " -- " << (uintptr_t) (link->aut) << ";\n";
+    }
+    for(SymLink* link : this->_auts) {
+        link->aut->DumpToDot(os, inComplement);
+    }
+}
+
 void ComplementAutomaton::DumpToDot(std::ofstream & os, bool inComplement) {
     os << "\t" << (uintptr_t) &*this << "[label=\"";
     os << "\u03B5 " << (inComplement ? "\u2209 " : "\u2208 ");
@@ -1150,6 +1437,14 @@ void BinaryOpAutomaton::DumpCacheStats() {
     this->_rhs_aut.aut->DumpCacheStats();
 }
 
+void NaryOpAutomaton::DumpCacheStats() {
+    this->_form->dump();
+    this->_resCache.dumpStats();
+    for(SymLink* link : this->_auts) {
+        link->aut->DumpCacheStats();
+    }
+}
+
 void ComplementAutomaton::DumpCacheStats() {
     this->_form->dump();
     this->_resCache.dumpStats();
@@ -1189,6 +1484,17 @@ void print_stat(std::string statName, std::string stat) {
     }
 }
 
+/**
+ * @return: bytes allocated by the caches of the node (without its subautomata)
+ */
+size_t SymbolicAutomaton::MemoryUsage() {
+    return this->_resCache.MemoryUsage() + this->_subCache.MemoryUsage() + this->_factory.MemoryUsage();
+}
+
+size_t BaseAutomaton::MemoryUsage() {
+    return SymbolicAutomaton::MemoryUsage() + this->_preCache.MemoryUsage();
+}
+
 void BinaryOpAutomaton::DumpStats() {
     if(this->marked) {
         return;
@@ -1202,6 +1508,9 @@ void BinaryOpAutomaton::DumpStats() {
 #       if (MEASURE_CACHE_HITS == true)
         this->_resCache.dumpStats();
 #       endif
+#       if (MEASURE_MEMORY == true)
+        print_stat("Memory", std::to_string(this->MemoryUsage() / 1024) + "kB");
+#       endif
 #       if (DEBUG_WORKSHOPS == true)
         this->_factory.Dump();
 #       endif
@@ -1218,6 +1527,44 @@ void BinaryOpAutomaton::DumpStats() {
     this->_rhs_aut.aut->DumpStats();
 }
 
+void NaryOpAutomaton::DumpStats() {
+    if(this->marked) {
+        return;
+    }
+    this->marked = true;
+#   if (PRINT_STATS_PRODUCT == true)
+    this->_form->dump();
+    std::cout << "\n";
+    print_stat("Refs", this->_refs);
+    std::cout << "  \u2218 Cache stats -> ";
+#       if (MEASURE_CACHE_HITS == true)
+        this->_resCache.dumpStats();
+#       endif
+#       if (MEASURE_MEMORY == true)
+        print_stat("Memory", std::to_string(this->MemoryUsage() / 1024) + "kB");
+#       endif
+#       if (DEBUG_WORKSHOPS == true)
+        this->_factory.Dump();
+#       endif
+#       if (DEBUG_SYMBOL_CREATION == true)
+        this->symbolFactory->Dump();
+#       endif
+        print_stat("True Hits", this->_trueCounter);
+        print_stat("False Hits", this->_falseCounter);
+        print_stat("Continuation Generation", this->_contCreationCounter);
+        print_stat("Continuation Evaluation", this->_contUnfoldingCounter);
+        std::string decisions;
+        for(size_t i : this->_order) {
+            decisions += std::to_string(i) + ":" + std::to_string(this->_decisions[i]) + " ";
+        }
+        print_stat("Operand Decisions", decisions);
+#   endif
+    std::cout << "\n";
+    for(SymLink* link : this->_auts) {
+        link->aut->DumpStats();
+    }
+}
+
 void ProjectionAutomaton::DumpStats() {
     if(this->marked) {
         return;
@@ -1231,6 +1578,9 @@ void ProjectionAutomaton::DumpStats() {
 #       if (MEASURE_CACHE_HITS == true)
         this->_resCache.dumpStats();
 #       endif
+#       if (MEASURE_MEMORY == true)
+        print_stat("Memory", std::to_string(this->MemoryUsage() / 1024) + "kB");
+#       endif
 #       if (DEBUG_WORKSHOPS)
         this->_factory.Dump();
 #       endif
@@ -1264,6 +1614,9 @@ void ComplementAutomaton::DumpStats() {
 #       if (MEASURE_CACHE_HITS == true)
         this->_resCache.dumpStats();
 #       endif
+#       if (MEASURE_MEMORY == true)
+        print_stat("Memory", std::to_string(this->MemoryUsage() / 1024) + "kB");
+#       endif
 #       if (DEBUG_WORKSHOPS)
         this->_factory.Dump();
 #       endif
@@ -1291,6 +1644,9 @@ void BaseAutomaton::DumpStats() {
 #       if (MEASURE_CACHE_HITS == true)
         this->_resCache.dumpStats();
 #       endif
+#       if (MEASURE_MEMORY == true)
+        print_stat("Memory", std::to_string(this->MemoryUsage() / 1024) + "kB");
+#       endif
 #       if (DEBUG_WORKSHOPS)
         this->_factory.Dump();
 #       endif
@@ -1300,6 +1656,9 @@ void BaseAutomaton::DumpStats() {
         print_stat("True Hits", this->_trueCounter);
         print_stat("False Hits", this->_falseCounter);
         print_stat("Continuation Evaluation", this->_contUnfoldingCounter);
+        if(GASTON_OPT(simulationSubsumption)) {
+            print_stat("Simulation Pairs", this->_simulation.NontrivialPairs());
+        }
 #   endif
     std::cout << "\n";
 }
@@ -1312,10 +1671,51 @@ unsigned int BinaryOpAutomaton::CountNodes() {
     return 1 + (this->_lhs_aut.remap ? 0 : this->_lhs_aut.aut->CountNodes()) + (this->_rhs_aut.remap ? 0 : this->_rhs_aut.aut->CountNodes());
 }
 
+unsigned int NaryOpAutomaton::CountNodes() {
+    unsigned int count = 1;
+    for(SymLink* link : this->_auts) {
+        count += (link->remap ? 0 : link->aut->CountNodes());
+    }
+    return count;
+}
+
 unsigned int BaseAutomaton::CountNodes() {
     return 1;
 }
 
 unsigned int ComplementAutomaton::CountNodes() {
     return 1 + (this->_aut.remap ? 0 : this->_aut.aut->CountNodes());
+}
+
+void ProjectionAutomaton::CollectBases(std::vector<BaseAutomaton*>& bases) {
+    if(!this->_aut.remap) {
+        this->_aut.aut->CollectBases(bases);
+    }
+}
+
+void BinaryOpAutomaton::CollectBases(std::vector<BaseAutomaton*>& bases) {
+    if(!this->_lhs_aut.remap) {
+        this->_lhs_aut.aut->CollectBases(bases);
+    }
+    if(!this->_rhs_aut.remap) {
+        this->_rhs_aut.aut->CollectBases(bases);
+    }
+}
+
+void NaryOpAutomaton::CollectBases(std::vector<BaseAutomaton*>& bases) {
+    for(SymLink* link : this->_auts) {
+        if(!link->remap) {
+            link->aut->CollectBases(bases);
+        }
+    }
+}
+
+void BaseAutomaton::CollectBases(std::vector<BaseAutomaton*>& bases) {
+    bases.push_back(this);
+}
+
+void ComplementAutomaton::CollectBases(std::vector<BaseAutomaton*>& bases) {
+    if(!this->_aut.remap) {
+        this->_aut.aut->CollectBases(bases);
+    }
 }
\ No newline at end of file
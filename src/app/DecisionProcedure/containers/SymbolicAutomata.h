@@ -29,6 +29,7 @@
 #include "../../Frontend/ident.h"
 #include "../../Frontend/ast.h"
 #include "../containers/VarToTrackMap.hh"
+#include "../containers/BaseSimulation.h"
 #include <vector>
 #include <vata/util/binary_relation.hh>
 #include <string>
@@ -44,6 +45,7 @@ using SymbolWorkshop    = Workshops::SymbolWorkshop;
 
 class SymbolicChecker;
 struct SymLink;
+class BaseAutomaton;
 
 /**
  * Base class for Symbolic Automata. Each symbolic automaton contains the
@@ -54,6 +56,7 @@ class SymbolicAutomaton {
 public:
     friend class SymbolicChecker;
     friend struct SymLink;
+    friend class Workshops::TermWorkshop;
 
     // <<< PUBLIC MEMBERS >>>
     static StateType stateCnt;
@@ -111,7 +114,9 @@ public:
     virtual void DumpCacheStats() = 0;
     virtual void DumpExample(ExampleType);
     virtual void DumpStats() = 0;
+    virtual size_t MemoryUsage();
     virtual unsigned int CountNodes() = 0;
+    virtual void CollectBases(std::vector<BaseAutomaton*>&) = 0;
     virtual void DumpToDot(std::ofstream&, bool) = 0;
     static void AutomatonToDot(std::string, SymbolicAutomaton*, bool);
 protected:
@@ -122,9 +127,12 @@ struct SymLink {
     SymbolicAutomaton* aut;
     bool remap;
     std::map<unsigned int, unsigned int>* varRemap;
+    size_t remapId;                 // << Unique identifier of the varRemap, that is never reused
 
-    SymLink() : aut(nullptr), remap(false), varRemap(nullptr) {}
-    explicit SymLink(SymbolicAutomaton* s) : aut(s), remap(false), varRemap(nullptr) {}
+    static size_t remapCounter;
+
+    SymLink() : aut(nullptr), remap(false), varRemap(nullptr), remapId(0) {}
+    explicit SymLink(SymbolicAutomaton* s) : aut(s), remap(false), varRemap(nullptr), remapId(0) {}
     ~SymLink() {
         if(varRemap != nullptr) {
             delete varRemap;
@@ -169,6 +177,7 @@ public:
     virtual void DumpStats();
     virtual void DumpCacheStats();
     virtual unsigned int CountNodes();
+    virtual void CollectBases(std::vector<BaseAutomaton*>&);
 protected:
     NEVER_INLINE virtual ~BinaryOpAutomaton();
 };
@@ -189,6 +198,68 @@ public:
     NEVER_INLINE UnionAutomaton(SymbolicAutomaton* lhs, SymbolicAutomaton* rhs, Formula_ptr form);
 };
 
+/**
+ * NaryOpAutomaton corresponds to the chain of Intersections (or Unions) of
+ * subautomata flattened into single node. Its terms are the right-leaning
+ * chains of the products of the operand terms (in the order of operands),
+ * but the operands are evaluated in the adaptive order: the ones that most
+ * often decided the result go first, so the evaluation can stop sooner.
+ */
+class NaryOpAutomaton : public SymbolicAutomaton {
+protected:
+    // <<< PRIVATE MEMBERS >>>
+    std::vector<SymLink*> _auts;
+    std::vector<size_t> _order;                 // Order of evaluation of the operands
+    std::vector<unsigned int> _decisions;       // Number of times the operand decided the result
+    unsigned int _evaluations = 0;
+    ProductType _productType;
+    bool (*_eval_result)(bool, bool, bool);     // Boolean function for evaluation of the accumulated and next results
+    bool (*_eval_early)(bool, bool);            // Boolean function for evaluating early evaluation
+    bool (*_early_val)(bool);                   // Boolean value of early result
+
+    // <<< PRIVATE FUNCTIONS >>>
+    virtual void _InitializeAutomaton();
+    virtual void _InitializeInitialStates();
+    virtual void _InitializeFinalStates();
+    virtual ResultType _IntersectNonEmptyCore(Symbol*, Term*, bool);
+    virtual void _DumpExampleCore(ExampleType);
+    Term_ptr _CreateProductChain(std::vector<Term_ptr>&);
+    void _SplitProductChain(Term_ptr, std::vector<Term_ptr>&);
+    void _ReorderOperands();
+
+public:
+    NEVER_INLINE NaryOpAutomaton(std::vector<std::pair<SymbolicAutomaton_raw, Formula_ptr>>& operands, Formula_ptr form);
+
+    // <<< PUBLIC API >>>
+    virtual Term* Pre(Symbol*, Term*, bool);
+
+    // <<< DUMPING FUNCTIONS >>>
+    virtual void DumpAutomaton();
+    virtual void DumpToDot(std::ofstream&, bool);
+    virtual void DumpStats();
+    virtual void DumpCacheStats();
+    virtual unsigned int CountNodes();
+    virtual void CollectBases(std::vector<BaseAutomaton*>&);
+protected:
+    NEVER_INLINE virtual ~NaryOpAutomaton();
+};
+
+/**
+ * Automaton corresponding to the formula: phi_1 and ... and phi_n
+ */
+class NaryIntersectionAutomaton : public NaryOpAutomaton {
+public:
+    NEVER_INLINE NaryIntersectionAutomaton(std::vector<std::pair<SymbolicAutomaton_raw, Formula_ptr>>& operands, Formula_ptr form);
+};
+
+/**
+ * Automaton corresponding to the formula: phi_1 or ... or phi_n
+ */
+class NaryUnionAutomaton : public NaryOpAutomaton {
+public:
+    NEVER_INLINE NaryUnionAutomaton(std::vector<std::pair<SymbolicAutomaton_raw, Formula_ptr>>& operands, Formula_ptr form);
+};
+
 /**
  * Automaton corresponding to the formulae: not phi
  */
@@ -217,6 +288,7 @@ public:
     virtual void DumpStats();
     virtual void DumpCacheStats();
     virtual unsigned int CountNodes();
+    virtual void CollectBases(std::vector<BaseAutomaton*>&);
 protected:
     NEVER_INLINE virtual ~ComplementAutomaton();
 };
@@ -262,6 +334,7 @@ public:
     virtual void DumpStats();
     virtual void DumpCacheStats();
     virtual unsigned int CountNodes();
+    virtual void CollectBases(std::vector<BaseAutomaton*>&);
 protected:
     NEVER_INLINE virtual ~ProjectionAutomaton();
 };
@@ -293,8 +366,11 @@ protected:
     unsigned int _stateSpace = 0;               // Number of states in automaton
     unsigned int _stateOffset = 0;              // Offset of states used for mask
     PreCache _preCache;
+    BaseSimulation _simulation;                 // Backward simulation used for subsumption of base sets
 
     /// <<< PRIVATE FUNCTIONS >>>
+    void _InitializeSimulation();
+    BaseSimulation* _GetSimulation();
     virtual void _InitializeAutomaton();
     virtual void _InitializeInitialStates();
     virtual void _InitializeFinalStates();
@@ -312,8 +388,10 @@ public:
     virtual void DumpToDot(std::ofstream&, bool);
     virtual void BaseAutDump();
     virtual void DumpStats();
+    virtual size_t MemoryUsage();
     virtual void DumpCacheStats();
     virtual unsigned int CountNodes();
+    virtual void CollectBases(std::vector<BaseAutomaton*>&);
 
 protected:
     NEVER_INLINE ~BaseAutomaton();
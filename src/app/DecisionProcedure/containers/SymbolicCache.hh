@@ -19,6 +19,7 @@
 
 #include <iomanip>
 #include <map>
+#include <set>
 #include <vector>
 #include <unordered_map>
 #include <typeinfo>
@@ -81,7 +82,9 @@ struct PreHashType {
 
 struct DagHashType {
 	size_t operator()(std::pair<ASTForm*, bool> const& f) const {
-		return boost::hash_value(f.first->kind);
+		size_t seed = f.first->DagHash();
+		boost::hash_combine(seed, f.second);
+		return seed;
 	}
 };
 
@@ -147,9 +150,28 @@ struct PrePairCompare : public std::binary_function<Key, Key, bool>
 
 template<class Key>
 struct DagCompare : public std::binary_function<Key, Key, bool> {
+	/**
+	 * @param lhs: left operand
+	 * @param rhs: right operand
+	 * @return true if lhs and rhs are the same modulo injective renaming of variables
+	 */
 	bool operator()(Key const& lhs, Key const& rhs) const {
-		bool result = lhs.second == rhs.second && lhs.first->StructuralCompare(rhs.first);
-		return result;
+		if(lhs.first == rhs.first) {
+			return lhs.second == rhs.second;
+		} else if(lhs.second != rhs.second) {
+			return false;
+		}
+
+		VarRenaming renaming;
+		if(!lhs.first->StructuralCompare(rhs.first, &renaming)) {
+			return false;
+		}
+		// Two different variables cannot be mapped to the same track
+		std::set<unsigned int> image;
+		for(auto& pair : renaming) {
+			image.insert(pair.second);
+		}
+		return image.size() == renaming.size();
 	}
 };
 
@@ -160,7 +182,7 @@ struct DagCompare : public std::binary_function<Key, Key, bool> {
  * CacheKey represents the key for lookup of CacheData
  * CacheData represents pure data that are stored inside cache
  */
-template<class Key, class CacheData, class KeyHash, class KeyCompare, void (*KeyDump)(Key const&), void (*DataDump)(CacheData&)>
+template<class Key, class CacheData, class KeyHash, class KeyCompare, void (*KeyDump)(Key const&), void (*DataDump)(CacheData&), Gaston::Memory::Category MemoryCategory>
 class BinaryCache {
 //	                                     this could be done better ---^----------------------------^
 private:
@@ -168,18 +190,26 @@ private:
 #   if (OPT_USE_DENSE_HASHMAP == true)
 	typedef google::dense_hash_map<Key, CacheData, KeyHash, KeyCompare> KeyToValueMap;
 #   else
-	typedef std::unordered_map<Key, CacheData, KeyHash, KeyCompare> KeyToValueMap;
+	typedef Gaston::Memory::Allocator<std::pair<const Key, CacheData>, MemoryCategory> Allocator;
+	typedef std::unordered_map<Key, CacheData, KeyHash, KeyCompare, Allocator> KeyToValueMap;
 #   endif
 	typedef typename KeyToValueMap::iterator iterator;
 	typedef typename KeyToValueMap::const_iterator const_iterator;
 
 	// < Private Members >
+#   if (MEASURE_MEMORY == true)
+	Gaston::Memory::Counter _memory;
+#   endif
 	KeyToValueMap _cache;
 	unsigned int cacheHits = 0;
 	unsigned int cacheMisses = 0;
 
 public:
+#   if (OPT_USE_DENSE_HASHMAP == true || MEASURE_MEMORY == false)
 	BinaryCache() {
+#   else
+	BinaryCache() : _cache(0, KeyHash(), KeyCompare(), Allocator(&this->_memory)) {
+#   endif
 #       if (OPT_USE_DENSE_HASHMAP == true)
 		this->_cache.set_empty_key(Key());
 #       endif
@@ -226,12 +256,47 @@ public:
 		}
 	}
 
+	// The allocator of the map refers to _memory of this cache
+	BinaryCache(const BinaryCache&) = delete;
+	BinaryCache& operator=(const BinaryCache&) = delete;
+
+	/**
+	 * @return: bytes allocated by the cache (without the dense hash map)
+	 */
+	size_t MemoryUsage() const {
+#       if (MEASURE_MEMORY == true)
+		return this->_memory.live;
+#       else
+		return 0;
+#       endif
+	}
+
 	/**
 	 * Clears the cache
 	 */
 	void clear() {
-		for(auto itPair = this->_cache.begin(); itPair != this->_cache.end(); ++itPair) {
-			itPair = this->_cache.erase(itPair);
+		this->_cache.clear();
+	}
+
+	/**
+	 * @param key: key we are removing from the cache
+	 */
+	void erase(const Key& key) {
+		this->_cache.erase(key);
+	}
+
+	/**
+	 * Removes the entries, for which the @p predicate (called with the key and the data) holds
+	 *
+	 * @param predicate: predicate over the entries
+	 */
+	template<class Predicate>
+	void EraseIf(Predicate predicate) {
+		for (auto it = this->_cache.begin(); it != this->_cache.end();) {
+			auto current = it++;
+			if (predicate(current->first, current->second)) {
+				this->_cache.erase(current);
+			}
 		}
 	}
 
@@ -54,6 +54,8 @@ TERM_MEASURELIST(INIT_ALL_STATIC_MEASURES)
 #undef INIT_ALL_STATIC_MEASURES
 #undef INIT_STATIC_MEASURE
 size_t TermFixpoint::subsumedByHits = 0;
+Term::TermCacheTable Term::_isSubsumedCaches;
+Term::TermCacheTable TermFixpoint::_subsumedByCaches;
 size_t TermFixpoint::preInstances = 0;
 size_t TermFixpoint::isNotShared = 0;
 size_t TermFixpoint::postponedTerms = 0;
@@ -64,9 +66,79 @@ size_t TermContinuation::unfoldInIsectNonempty = 0;
 
 extern Ident lastPosVar, allPosVar;
 
+#if (MEASURE_MEMORY == true)
+namespace {
+    /**
+     * Returns the size of the term of type @p type and sets the @p category its memory is charged to
+     */
+    size_t termFootprint(TermType type, Gaston::Memory::Category& category) {
+        switch(type) {
+            case TERM_EMPTY:        category = Gaston::Memory::TermEmpty; return sizeof(TermEmpty);
+            case TERM_PRODUCT:      category = Gaston::Memory::TermProduct; return sizeof(TermProduct);
+            case TERM_BASE:         category = Gaston::Memory::TermBaseSet; return sizeof(TermBaseSet);
+            case TERM_LIST:         category = Gaston::Memory::TermList; return sizeof(TermList);
+            case TERM_FIXPOINT:     category = Gaston::Memory::TermFixpoint; return sizeof(TermFixpoint);
+            case TERM_CONTINUATION: category = Gaston::Memory::TermContinuation; return sizeof(TermContinuation);
+            default:
+                assert(false && "Accounting memory of abstract term");
+                category = Gaston::Memory::Caches;
+                return sizeof(Term);
+        }
+    }
+
+    void allocateTerm(Term* term) {
+        Gaston::Memory::Category category;
+        size_t bytes = termFootprint(term->type, category);
+        Gaston::Memory::Allocate(category, bytes);
+    }
+
+    void freeTerm(Term* term) {
+        Gaston::Memory::Category category;
+        size_t bytes = termFootprint(term->type, category);
+        Gaston::Memory::Free(category, bytes);
+    }
+}
+#endif
+
 // <<< TERM CONSTRUCTORS AND DESTRUCTORS >>>
 Term::Term(): link{ nullptr, nullptr, 0} {}
-Term::~Term() {}
+Term::~Term() {
+    if(this->_hasIsSubsumedCache) {
+        Term::_ReleaseCacheOf(Term::_isSubsumedCaches, this);
+    }
+    #if (MEASURE_MEMORY == true)
+    freeTerm(this);
+    #endif
+}
+
+/**
+ * Returns the cache of the @p term from the side @p table, creating it on the first use
+ *
+ * @param[in] table:    side table of the caches
+ * @param[in] term:     owner of the cache
+ * @return:             cache of the @p term
+ */
+TermCache& Term::_CacheOf(TermCacheTable& table, const Term* term) {
+    TermCache*& cache = table[term];
+    if(cache == nullptr) {
+        cache = new TermCache();
+    }
+    return *cache;
+}
+
+/**
+ * Releases the cache of the @p term from the side @p table
+ *
+ * @param[in] table:    side table of the caches
+ * @param[in] term:     owner of the cache
+ */
+void Term::_ReleaseCacheOf(TermCacheTable& table, const Term* term) {
+    auto it = table.find(term);
+    if(it != table.end()) {
+        delete it->second;
+        table.erase(it);
+    }
+}
 
 TermEmpty::TermEmpty(bool inComplement) {
     #if (MEASURE_STATE_SPACE == true)
@@ -74,6 +146,9 @@ TermEmpty::TermEmpty(bool inComplement) {
     #endif
     this->_inComplement = inComplement;
     this->type = TERM_EMPTY;
+    #if (MEASURE_MEMORY == true)
+    allocateTerm(this);
+    #endif
 
     // Initialization of state space
     this->stateSpace = 0;
@@ -87,10 +162,6 @@ TermEmpty::TermEmpty(bool inComplement) {
     #endif
 }
 
-/*Term::~Term() {
-    this->_isSubsumedCache.clear();
-}*/
-
 /**
  * Constructor of Term Product---construct intersecting product of
  * @p lhs and @p rhs
@@ -105,6 +176,9 @@ TermProduct::TermProduct(Term_ptr lhs, Term_ptr rhs, ProductType pt) : left(lhs)
 
     this->_inComplement = false;
     this->type = TermType::TERM_PRODUCT;
+    #if (MEASURE_MEMORY == true)
+    allocateTerm(this);
+    #endif
     this->subtype = pt;
 
     // Initialization of state space
@@ -122,11 +196,14 @@ TermProduct::TermProduct(Term_ptr lhs, Term_ptr rhs, ProductType pt) : left(lhs)
     #endif
 }
 
-TermBaseSet::TermBaseSet(VATA::Util::OrdVector<size_t>& s, unsigned int offset, unsigned int stateNo) : states() {
+TermBaseSet::TermBaseSet(VATA::Util::OrdVector<size_t>& s, unsigned int offset, unsigned int stateNo, BaseSimulation* sim) : states(), simulation(sim) {
     #if (MEASURE_STATE_SPACE == true)
     ++TermBaseSet::instances;
     #endif
     type = TERM_BASE;
+    #if (MEASURE_MEMORY == true)
+    allocateTerm(this);
+    #endif
     for(auto state : s) {
         this->states.push_back(state);
     }
@@ -160,6 +237,9 @@ TermContinuation::TermContinuation(SymbolicAutomaton* a, Term* t, SymbolType* s,
     assert(t != nullptr);
 
     this->type = TERM_CONTINUATION;
+    #if (MEASURE_MEMORY == true)
+    allocateTerm(this);
+    #endif
 
     // Initialization of state space
     this->stateSpace = 0;
@@ -180,6 +260,9 @@ TermList::TermList(Term_ptr first, bool isCompl) {
     #endif
 
     this->type = TERM_LIST;
+    #if (MEASURE_MEMORY == true)
+    allocateTerm(this);
+    #endif
 
     // Initialization of state space
     if(first->stateSpace) {
@@ -219,6 +302,9 @@ TermFixpoint::TermFixpoint(Aut_ptr aut, Term_ptr startingTerm, Symbol* symbol, b
     this->_nonMembershipTesting = inComplement;
     this->_inComplement = false;
     this->type = TERM_FIXPOINT;
+    #if (MEASURE_MEMORY == true)
+    allocateTerm(this);
+    #endif
     this->_searchType = search;
 
     // Initialize the state space
@@ -266,6 +352,9 @@ TermFixpoint::TermFixpoint(Aut_ptr aut, Term_ptr sourceTerm, Symbol* symbol, boo
     // Initialize the aggregate function
     this->_InitializeAggregateFunction(inComplement);
     this->type = TERM_FIXPOINT;
+    #if (MEASURE_MEMORY == true)
+    allocateTerm(this);
+    #endif
     this->_searchType = WorklistSearchType::E_DFS;
     this->_nonMembershipTesting = inComplement;
     this->_inComplement = false;
@@ -284,6 +373,9 @@ TermFixpoint::TermFixpoint(Aut_ptr aut, Term_ptr sourceTerm, Symbol* symbol, boo
 }
 
 TermFixpoint::~TermFixpoint() {
+    if(this->_hasSubsumedByCache) {
+        Term::_ReleaseCacheOf(TermFixpoint::_subsumedByCaches, this);
+    }
     this->_fixpoint.clear();
     this->_postponed.clear();
     this->_worklist.clear();
@@ -319,59 +411,102 @@ bool Term::IsNotComputed() {
 #endif
 }
 
+// Defaults of the switches, used until the SelectOptimizations() is called
+#define DEFAULT_SUBSUMPTION_SWITCHES \
+    ((Gaston::Configuration::Defaults::cacheSubsumes ? Term::SS_CACHE_SUBSUMES : 0u) | \
+     (Gaston::Configuration::Defaults::earlyPartialSub ? Term::SS_EARLY_PARTIAL_SUB : 0u) | \
+     (Gaston::Configuration::Defaults::simulationSubsumption ? Term::SS_SIMULATION : 0u))
+
+Term::IsSubsumedFunction Term::_isSubsumed = &Term::_IsSubsumed<DEFAULT_SUBSUMPTION_SWITCHES>;
+Term::IsSubsumedFunction Term::_isSubsumedDispatch = &Term::_IsSubsumedDispatch<DEFAULT_SUBSUMPTION_SWITCHES>;
+void (TermFixpoint::*TermFixpoint::_pushSymbols)(Term_ptr) =
+    &TermFixpoint::_EnqueueSymbols<Gaston::Configuration::Defaults::fixpointBfsSearch>;
+#undef DEFAULT_SUBSUMPTION_SWITCHES
+
+/**
+ * Selects the instantiations of the hot paths of the terms according to the current switches (see
+ * utils/Configuration.h), so the switches are not tested during the computation. Has to be called after the
+ * switches are set and before the decision procedure.
+ */
+void Term::SelectOptimizations() {
+    static const IsSubsumedFunction isSubsumed[] = {
+        &Term::_IsSubsumed<0>, &Term::_IsSubsumed<1>, &Term::_IsSubsumed<2>, &Term::_IsSubsumed<3>,
+        &Term::_IsSubsumed<4>, &Term::_IsSubsumed<5>, &Term::_IsSubsumed<6>, &Term::_IsSubsumed<7>
+    };
+    static const IsSubsumedFunction isSubsumedDispatch[] = {
+        &Term::_IsSubsumedDispatch<0>, &Term::_IsSubsumedDispatch<1>, &Term::_IsSubsumedDispatch<2>,
+        &Term::_IsSubsumedDispatch<3>, &Term::_IsSubsumedDispatch<4>, &Term::_IsSubsumedDispatch<5>,
+        &Term::_IsSubsumedDispatch<6>, &Term::_IsSubsumedDispatch<7>
+    };
+    static_assert(sizeof(isSubsumed) / sizeof(isSubsumed[0]) == SS_ALL + 1, "Missing instantiation of _IsSubsumed");
+
+    unsigned int switches = (GASTON_OPT(cacheSubsumes) ? SS_CACHE_SUBSUMES : 0u) |
+                            (GASTON_OPT(earlyPartialSub) ? SS_EARLY_PARTIAL_SUB : 0u) |
+                            (GASTON_OPT(simulationSubsumption) ? SS_SIMULATION : 0u);
+    Term::_isSubsumed = isSubsumed[switches];
+    Term::_isSubsumedDispatch = isSubsumedDispatch[switches];
+
+    if(GASTON_OPT(fixpointBfsSearch)) {
+        TermFixpoint::_pushSymbols = &TermFixpoint::_EnqueueSymbols<true>;
+    } else {
+        TermFixpoint::_pushSymbols = &TermFixpoint::_EnqueueSymbols<false>;
+    }
+}
+
 /**
  * Tests the Term subsumption
  *
+ * @param[in] lhs:  tested term
  * @param[in] t:    term we are testing subsumption against
- * @return:         true if this is subsumed by @p t
+ * @return:         true if @p lhs is subsumed by @p t
  */
-SubsumptionResult Term::IsSubsumed(Term *t, bool unfoldAll) {
+template<unsigned Switches>
+SubsumptionResult Term::_IsSubsumed(Term* lhs, Term *t, bool unfoldAll) {
     // unfold the continuation
-    if(this == t) {
+    if(lhs == t) {
         return E_TRUE;
     }
 
     if(t->type == TERM_CONTINUATION) {
         TermContinuation *continuation = reinterpret_cast<TermContinuation *>(t);
         Term* unfoldedContinuation = continuation->unfoldContinuation(UnfoldedInType::E_IN_SUBSUMPTION);
-        return this->IsSubsumed(unfoldedContinuation, unfoldAll);
-    } else if(this->type == TERM_CONTINUATION) {
-        TermContinuation *continuation = reinterpret_cast<TermContinuation *>(this);
+        return Term::_IsSubsumed<Switches>(lhs, unfoldedContinuation, unfoldAll);
+    } else if(lhs->type == TERM_CONTINUATION) {
+        TermContinuation *continuation = reinterpret_cast<TermContinuation *>(lhs);
         Term* unfoldedContinuation = continuation->unfoldContinuation(UnfoldedInType::E_IN_SUBSUMPTION);
-        return unfoldedContinuation->IsSubsumed(t, unfoldAll);
+        return Term::_IsSubsumed<Switches>(unfoldedContinuation, t, unfoldAll);
     }
-    if(this->_inComplement != t->_inComplement) {
-        this->dump(); std::cout << " and ";t->dump(); std::cout << "\n";
+    if(lhs->_inComplement != t->_inComplement) {
+        lhs->dump(); std::cout << " and ";t->dump(); std::cout << "\n";
     }
-    assert(this->_inComplement == t->_inComplement);
-    assert(this->type != TERM_CONTINUATION && t->type != TERM_CONTINUATION);
+    assert(lhs->_inComplement == t->_inComplement);
+    assert(lhs->type != TERM_CONTINUATION && t->type != TERM_CONTINUATION);
 
     // Else if it is not continuation we first look into cache and then recompute if needed
     SubsumptionResult result;
-    #if (OPT_CACHE_SUBSUMES == true)
-    if(this->type != TERM_FIXPOINT || !this->_isSubsumedCache.retrieveFromCache(t, result)) {
-    #endif
-        if (this->_inComplement) {
-            if(this->type == TERM_EMPTY) {
+    bool cacheSubsumes = (Switches & SS_CACHE_SUBSUMES) && lhs->type == TERM_FIXPOINT;
+    if(!cacheSubsumes || !lhs->_hasIsSubsumedCache || !Term::_CacheOf(Term::_isSubsumedCaches, lhs).retrieveFromCache(t, result)) {
+        if (lhs->_inComplement) {
+            if(lhs->type == TERM_EMPTY) {
                 result = (t->type == TERM_EMPTY ? E_TRUE : E_FALSE);
             } else {
-                result = t->_IsSubsumedCore(this, unfoldAll);
+                result = Term::_IsSubsumedDispatch<Switches>(t, lhs, unfoldAll);
             }
         } else {
             if(t->type == TERM_EMPTY) {
-                result = (this->type == TERM_EMPTY ? E_TRUE : E_FALSE);
+                result = (lhs->type == TERM_EMPTY ? E_TRUE : E_FALSE);
             } else {
-                result = this->_IsSubsumedCore(t, unfoldAll);
+                result = Term::_IsSubsumedDispatch<Switches>(lhs, t, unfoldAll);
             }
         }
-    #if (OPT_CACHE_SUBSUMES == true)
-        if(result != E_PARTIALLY && this->type == TERM_FIXPOINT)
-            this->_isSubsumedCache.StoreIn(t, result);
+        if(cacheSubsumes && result != E_PARTIALLY) {
+            Term::_CacheOf(Term::_isSubsumedCaches, lhs).StoreIn(t, result);
+            lhs->_hasIsSubsumedCache = true;
+        }
     }
-    #endif
     assert(!unfoldAll || result != E_PARTIALLY);
 #   if (DEBUG_TERM_SUBSUMPTION == true)
-    this->dump();
+    lhs->dump();
     std::cout << (result == E_TRUE ? " \u2291 " : " \u22E2 ");
     t->dump();
     std::cout << " = " << (result == E_TRUE ? "true" : "false") << "\n\n";
@@ -379,12 +514,40 @@ SubsumptionResult Term::IsSubsumed(Term *t, bool unfoldAll) {
     return result;
 }
 
+/**
+ * Calls the _IsSubsumedCore of the @p lhs according to its type. The empty terms, products and base sets, that form
+ * the bulk of the subsumption testing, are called directly, so the recursion over products can be inlined.
+ *
+ * @param[in] lhs:          tested term
+ * @param[in] rhs:          subsuming term
+ * @param[in] unfoldAll:    true if continuations should be unfolded
+ * @return:                 result of the subsumption
+ */
+template<unsigned Switches>
+SubsumptionResult Term::_IsSubsumedDispatch(Term* lhs, Term* rhs, bool unfoldAll) {
+    switch(lhs->type) {
+        case TERM_EMPTY:
+            return static_cast<TermEmpty*>(lhs)->TermEmpty::_IsSubsumedCore(rhs, unfoldAll);
+        case TERM_PRODUCT:
+            return static_cast<TermProduct*>(lhs)->template _IsSubsumedWith<Switches>(rhs, unfoldAll);
+        case TERM_BASE:
+            return static_cast<TermBaseSet*>(lhs)->template _IsSubsumedWith<Switches>(rhs, unfoldAll);
+        default:
+            return lhs->_IsSubsumedCore(rhs, unfoldAll);
+    }
+}
+
 SubsumptionResult TermEmpty::_IsSubsumedCore(Term *t, bool unfoldAll) {
     // Empty term is subsumed by everything (probably)
     return (this->_inComplement) ? (t->type == TERM_EMPTY ? E_TRUE : E_FALSE) : E_TRUE;
 }
 
 SubsumptionResult TermProduct::_IsSubsumedCore(Term* t, bool unfoldAll) {
+    return Term::_isSubsumedDispatch(this, t, unfoldAll);
+}
+
+template<unsigned Switches>
+SubsumptionResult TermProduct::_IsSubsumedWith(Term* t, bool unfoldAll) {
     assert(t->type == TERM_PRODUCT);
 
     // Retype and test the subsumption component-wise
@@ -395,60 +558,47 @@ SubsumptionResult TermProduct::_IsSubsumedCore(Term* t, bool unfoldAll) {
     Term *rhsr = rhs->right;
 
     if(!unfoldAll && (lhsr->IsNotComputed() && rhsr->IsNotComputed())) {
-        #if (OPT_EARLY_PARTIAL_SUB == true)
-        if(lhsr->type == TERM_CONTINUATION && rhsr->type == TERM_CONTINUATION) {
-            return (lhsl->IsSubsumed(rhsl, unfoldAll) == E_FALSE ? E_FALSE : E_PARTIALLY);
+        if(!(Switches & SS_EARLY_PARTIAL_SUB)) {
+            return (Term::_IsSubsumed<Switches>(lhsl, rhsl, false) != E_FALSE && Term::_IsSubsumed<Switches>(lhsr, rhsr, false) != E_FALSE) ? E_TRUE : E_FALSE;
+        } else if(lhsr->type == TERM_CONTINUATION && rhsr->type == TERM_CONTINUATION) {
+            return (Term::_IsSubsumed<Switches>(lhsl, rhsl, unfoldAll) == E_FALSE ? E_FALSE : E_PARTIALLY);
         } else {
-            SubsumptionResult leftIsSubsumed = lhsl->IsSubsumed(rhsl, unfoldAll);
+            SubsumptionResult leftIsSubsumed = Term::_IsSubsumed<Switches>(lhsl, rhsl, unfoldAll);
             if(leftIsSubsumed == E_TRUE) {
-                return lhsr->IsSubsumed(rhsr, unfoldAll);
+                return Term::_IsSubsumed<Switches>(lhsr, rhsr, unfoldAll);
             } else {
                 return leftIsSubsumed;
             }
         }
-        #else
-        return (lhsl->IsSubsumed(rhsl) != E_FALSE && lhsr->IsSubsumed(rhsr) != E_FALSE) ? E_TRUE : E_FALSE;
-        #endif
     } if(!unfoldAll && lhsl == rhsl) {
-        return lhsr->IsSubsumed(rhsr, unfoldAll);
+        return Term::_IsSubsumed<Switches>(lhsr, rhsr, unfoldAll);
     } else if(!unfoldAll && lhsr == rhsr) {
-        return lhsl->IsSubsumed(rhsl, unfoldAll);
+        return Term::_IsSubsumed<Switches>(lhsl, rhsl, unfoldAll);
     } else {
         if(lhsl->stateSpaceApprox < lhsr->stateSpaceApprox || unfoldAll) {
-            return (lhsl->IsSubsumed(rhsl, unfoldAll) != E_FALSE && lhsr->IsSubsumed(rhsr, unfoldAll) != E_FALSE) ? E_TRUE : E_FALSE;
+            return (Term::_IsSubsumed<Switches>(lhsl, rhsl, unfoldAll) != E_FALSE && Term::_IsSubsumed<Switches>(lhsr, rhsr, unfoldAll) != E_FALSE) ? E_TRUE : E_FALSE;
         } else {
-            return (lhsr->IsSubsumed(rhsr, unfoldAll) != E_FALSE && lhsl->IsSubsumed(rhsl, unfoldAll) != E_FALSE) ? E_TRUE : E_FALSE;
+            return (Term::_IsSubsumed<Switches>(lhsr, rhsr, unfoldAll) != E_FALSE && Term::_IsSubsumed<Switches>(lhsl, rhsl, unfoldAll) != E_FALSE) ? E_TRUE : E_FALSE;
         }
     }
 }
 
 SubsumptionResult TermBaseSet::_IsSubsumedCore(Term* term, bool unfoldAll) {
+    return Term::_isSubsumedDispatch(this, term, unfoldAll);
+}
+
+template<unsigned Switches>
+SubsumptionResult TermBaseSet::_IsSubsumedWith(Term* term, bool unfoldAll) {
     assert(term->type == TERM_BASE);
 
-    // Test component-wise, not very efficient though
-    // TODO: Change to bit-vectors if possible
+    // States are ordered, so the inclusion is tested by the (vectorized) kernel for sorted sets
     TermBaseSet *t = reinterpret_cast<TermBaseSet*>(term);
-    if(t->states.size() < this->states.size()) {
-        return E_FALSE;
-    } else {
-        // TODO: Maybe we could exploit that we have ordered vectors
-        auto it = this->states.begin();
-        auto end = this->states.end();
-        auto tit = t->states.begin();
-        auto tend = t->states.end();
-        while(it != end && tit != tend) {
-            if(*it == *tit) {
-                ++it;
-                ++tit;
-            } else if(*it > *tit) {
-                ++tit;
-            } else {
-                // *it < *tit
-                return E_FALSE;
-            }
-        }
-        return (it == end) ? E_TRUE : E_FALSE;
+    bool isIncluded = VATA::Util::SortedKernels::Includes(this->states.data(), this->states.size(), t->states.data(), t->states.size());
+    // Otherwise each state has to be simulated by some state of the bigger set
+    if(!isIncluded && (Switches & SS_SIMULATION) && this->simulation != nullptr) {
+        isIncluded = this->simulation->IsCovered(this->states.data(), this->states.size(), t->states.data(), t->states.size());
     }
+    return isIncluded ? E_TRUE : E_FALSE;
 }
 
 SubsumptionResult TermContinuation::_IsSubsumedCore(Term *t, bool unfoldAll) {
@@ -642,14 +792,30 @@ SubsumptionResult TermFixpoint::IsSubsumedBy(FixpointType& fixpoint, Term*& bigg
 }
 
 /**
- * Tests the emptiness of Term
+ * Calls the IsEmpty of the @p term according to its type, directly for empty terms, products and base sets
+ *
+ * @param[in] term:     tested term
+ * @return:             true if the @p term is empty
  */
+bool Term::_IsEmptyDispatch(Term* term) {
+    switch(term->type) {
+        case TERM_EMPTY:
+            return static_cast<TermEmpty*>(term)->TermEmpty::IsEmpty();
+        case TERM_PRODUCT:
+            return static_cast<TermProduct*>(term)->TermProduct::IsEmpty();
+        case TERM_BASE:
+            return static_cast<TermBaseSet*>(term)->TermBaseSet::IsEmpty();
+        default:
+            return term->IsEmpty();
+    }
+}
+
 bool TermEmpty::IsEmpty() {
     return true;
 }
 
 bool TermProduct::IsEmpty() {
-    return this->left->IsEmpty() && this->right->IsEmpty();
+    return Term::_IsEmptyDispatch(this->left) && Term::_IsEmptyDispatch(this->right);
 }
 
 bool TermBaseSet::IsEmpty() {
@@ -902,14 +1068,7 @@ void TermFixpoint::_dumpCore(unsigned indent) {
 // <<< ADDITIONAL TERMBASESET FUNCTIONS >>>
 
 bool TermBaseSet::Intersects(TermBaseSet* rhs) {
-    for (auto lhs_state : this->states) {
-        for(auto& rhs_state : rhs->states) {
-            if(lhs_state == rhs_state) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return VATA::Util::SortedKernels::Intersects(this->states.data(), this->states.size(), rhs->states.data(), rhs->states.size());
 }
 
 // <<< ADDITIONAL TERMFIXPOINT FUNCTIONS >>>
@@ -983,6 +1142,7 @@ bool TermFixpoint::_processOnePostponed() {
 }
 
 SubsumptionResult TermFixpoint::_fixpointTest(Term_ptr const &term) {
+    TRACE_SPAN("FixpointTest", this, Gaston::Trace::NoKind);
     if(this->_searchType == WorklistSearchType::E_UNGROUND_ROOT) {
         // Fixme: Not sure if this is really correct, but somehow I still feel that the Root search is special and
         //   subsumption is maybe not enough? But maybe this simply does not work for fixpoints of negated thing.
@@ -1014,10 +1174,11 @@ SubsumptionResult TermFixpoint::_testIfSubsumes(Term_ptr const& term) {
     #if (OPT_CACHE_SUBSUMED_BY == true)
     SubsumptionResult result;
     Term* key = term, *subsumedByTerm;
-    if(!this->_subsumedByCache.retrieveFromCache(key, result)) {
+    if(!this->_hasSubsumedByCache || !Term::_CacheOf(TermFixpoint::_subsumedByCaches, this).retrieveFromCache(key, result)) {
         // True/Partial results are stored in cache
         if((result = term->IsSubsumedBy(this->_fixpoint, subsumedByTerm)) != E_FALSE) {
-            this->_subsumedByCache.StoreIn(key, result);
+            Term::_CacheOf(TermFixpoint::_subsumedByCaches, this).StoreIn(key, result);
+            this->_hasSubsumedByCache = true;
         }
 
         if(result == E_PARTIALLY) {
@@ -1056,6 +1217,7 @@ WorklistItemType TermFixpoint::_popFromWorklist() {
  */
 void TermFixpoint::ComputeNextFixpoint() {
     assert(!_worklist.empty());
+    TRACE_SPAN("ComputeNextFixpoint", this, Gaston::Trace::NoKind);
 
     // Pop the front item from worklist
     WorklistItemType item = this->_popFromWorklist();
@@ -1075,13 +1237,7 @@ void TermFixpoint::ComputeNextFixpoint() {
     // Aggregate the result of the fixpoint computation
     _bValue = this->_aggregate_result(_bValue,result.second);
     // Push new symbols from _symList
-    for(auto& symbol : _symList) {
-#       if (OPT_FIXPOINT_BFS_SEARCH == true)
-        _worklist.push_back(std::make_pair(result.first, symbol));
-#       else
-        _worklist.insert(_worklist.cbegin(), std::make_pair(result.first, symbol));
-#       endif
-    }
+    this->_PushSymbols(result.first);
 }
 
 /**
@@ -1090,6 +1246,7 @@ void TermFixpoint::ComputeNextFixpoint() {
  */
 void TermFixpoint::ComputeNextPre() {
     assert(!_worklist.empty());
+    TRACE_SPAN("ComputeNextPre", this, Gaston::Trace::NoKind);
 
     // Pop item from worklist
     WorklistItemType item = this->_popFromWorklist();
@@ -1241,6 +1398,7 @@ FixpointTermSem TermFixpoint::GetSemantics() const {
 // <<< ADDITIONAL TERMCONTINUATION FUNCTIONS >>>
 Term* TermContinuation::unfoldContinuation(UnfoldedInType t) {
     if(this->_unfoldedTerm == nullptr) {
+        TRACE_SPAN("UnfoldContinuation", this, Gaston::Trace::NoKind);
         this->_unfoldedTerm = (this->aut->IntersectNonEmpty(
                 (this->symbol == nullptr ? nullptr : this->symbol), this->term, this->underComplement)).first;
         #if (MEASURE_CONTINUATION_EVALUATION == true)
@@ -1398,15 +1556,35 @@ bool Term::operator==(const Term &t) {
         return tthis == tt;
     } else {
         #if (MEASURE_COMPARISONS == true)
-        bool result = tthis->_eqCore(*tt);
+        bool result = Term::_EqDispatch(tthis, *tt);
         Term::comparedByStructure(tthis->type, result);
         return result;
         #else
-        return tthis->_eqCore(*tt);
+        return Term::_EqDispatch(tthis, *tt);
         #endif
     }
 }
 
+/**
+ * Calls the _eqCore of the @p lhs according to its type, directly for empty terms, products and base sets
+ *
+ * @param[in] lhs:      compared term
+ * @param[in] rhs:      term of the same type as @p lhs
+ * @return:             true if the terms are equal
+ */
+bool Term::_EqDispatch(Term* lhs, const Term& rhs) {
+    switch(lhs->type) {
+        case TERM_EMPTY:
+            return static_cast<TermEmpty*>(lhs)->TermEmpty::_eqCore(rhs);
+        case TERM_PRODUCT:
+            return static_cast<TermProduct*>(lhs)->TermProduct::_eqCore(rhs);
+        case TERM_BASE:
+            return static_cast<TermBaseSet*>(lhs)->TermBaseSet::_eqCore(rhs);
+        default:
+            return lhs->_eqCore(rhs);
+    }
+}
+
 bool TermEmpty::_eqCore(const Term &t) {
     assert(t.type == TERM_EMPTY && "Testing equality of different term types");
     return true;
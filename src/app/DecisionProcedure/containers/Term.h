@@ -19,11 +19,14 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <unordered_map>
 #include "../utils/Symbol.h"
 #include "../mtbdd/ondriks_mtbdd.hh"
 #include "../containers/SymbolicAutomata.h"
 #include "../environment.hh"
 #include "../containers/Workshops.h"
+#include "../utils/Configuration.h"
+#include "../utils/Tracer.h"
 
 // <<< MACROS >>>
 
@@ -55,19 +58,19 @@ using Term_ptr          = Term*;
 using TermProductStates = std::pair<Term_ptr, Term_ptr>;
 using TermListStates    = std::vector<Term_ptr>;
 using BaseState         = size_t;
-using TermBaseSetStates = std::vector<BaseState>;
+using TermBaseSetStates = std::vector<BaseState, Gaston::Memory::Allocator<BaseState, Gaston::Memory::TermBaseSet>>;
 using ResultType        = std::pair<Term_ptr, bool>;
 using ExamplePair       = std::pair<Term_ptr, Term_ptr>;
 using SymbolType        = ZeroSymbol;
 
 using FixpointMember = std::pair<Term_ptr, bool>;
-using FixpointType = std::list<FixpointMember>;
-using TermListType = std::list<std::pair<Term_ptr, Term_ptr>>;
+using FixpointType = std::list<FixpointMember, Gaston::Memory::Allocator<FixpointMember, Gaston::Memory::FixpointLists>>;
+using TermListType = std::list<std::pair<Term_ptr, Term_ptr>, Gaston::Memory::Allocator<std::pair<Term_ptr, Term_ptr>, Gaston::Memory::FixpointLists>>;
 using Aut_ptr = SymbolicAutomaton*;
 
 using WorklistItemType = std::pair<Term_ptr, SymbolType*>;
-using WorklistType = std::list<WorklistItemType>;
-using Symbols = std::list<SymbolType*>;
+using WorklistType = std::list<WorklistItemType, Gaston::Memory::Allocator<WorklistItemType, Gaston::Memory::FixpointLists>>;
+using Symbols = std::list<SymbolType*, Gaston::Memory::Allocator<SymbolType*, Gaston::Memory::SymbolLists>>;
 
 
 class Term {
@@ -75,7 +78,9 @@ class Term {
 
     // <<< MEMBERS >>>
 protected:
-    TermCache _isSubsumedCache;     // [36B] << Cache for results of subsumption
+    // Caches are rarely used, so they are kept out of the terms in the side tables keyed by the terms
+    using TermCacheTable = std::unordered_map<const Term*, TermCache*>;
+    static TermCacheTable _isSubsumedCaches;   // << Caches for results of subsumption (created on first use)
 public:
     struct {                        // [12B] << Link for counterexamplse
         Term* succ;
@@ -89,6 +94,7 @@ public:
 protected:
     bool _nonMembershipTesting;     // [1B] << We are testing the nonmembership for this term
     bool _inComplement;             // [1B] << Term is complemented
+    bool _hasIsSubsumedCache = false;   // [1B] << Term has the cache in _isSubsumedCaches
 public:
 
     NEVER_INLINE Term();
@@ -99,8 +105,9 @@ public:
 
 public:
     // <<< PUBLIC API >>>
+    static void SelectOptimizations();
     virtual SubsumptionResult IsSubsumedBy(FixpointType& fixpoint, Term*&) = 0;
-    virtual SubsumptionResult IsSubsumed(Term* t, bool b = false);
+    SubsumptionResult IsSubsumed(Term* t, bool b = false) { return Term::_isSubsumed(this, t, b); }
     virtual bool IsEmpty() = 0;
     virtual void Complement();
     virtual bool InComplement() {return this->_inComplement;}
@@ -120,7 +127,26 @@ public:
     // <<< DUMPING FUNCTIONS >>>
     virtual void dump(unsigned indent = 0);
 protected:
+    // Switches of the subsumption testing, its hot path is instantiated for each of their combinations
+    enum SubsumptionSwitch : unsigned {
+        SS_CACHE_SUBSUMES = 1,          // << GASTON_OPT(cacheSubsumes)
+        SS_EARLY_PARTIAL_SUB = 2,       // << GASTON_OPT(earlyPartialSub)
+        SS_SIMULATION = 4,              // << GASTON_OPT(simulationSubsumption)
+        SS_ALL = 7
+    };
+    using IsSubsumedFunction = SubsumptionResult (*)(Term*, Term*, bool);
+    static IsSubsumedFunction _isSubsumed;          // << Instantiation of _IsSubsumed for the current switches
+    static IsSubsumedFunction _isSubsumedDispatch;  // << Instantiation of _IsSubsumedDispatch for the current switches
+
     // <<< PRIVATE FUNCTIONS >>>
+    template<unsigned Switches>
+    static SubsumptionResult _IsSubsumed(Term* lhs, Term* rhs, bool b);
+    template<unsigned Switches>
+    static SubsumptionResult _IsSubsumedDispatch(Term* lhs, Term* rhs, bool b);
+    static bool _IsEmptyDispatch(Term* term);
+    static bool _EqDispatch(Term* lhs, const Term& rhs);
+    static TermCache& _CacheOf(TermCacheTable& table, const Term* term);
+    static void _ReleaseCacheOf(TermCacheTable& table, const Term* term);
     virtual unsigned int _MeasureStateSpaceCore() = 0;
     virtual SubsumptionResult _IsSubsumedCore(Term* t, bool b = false) = 0;
     virtual void _dumpCore(unsigned indent = 0) = 0;
@@ -134,6 +160,7 @@ protected:
  * Class that represents the empty term. Should be unique through the computation
  */
 class TermEmpty : public Term {
+    friend class Term;
 public:
     // See #L29
     TERM_MEASURELIST(DEFINE_STATIC_MEASURE)
@@ -161,6 +188,7 @@ private:
  * {1, 2} x {4, 5}, which can also be implemented as set of pairs
  */
 class TermProduct : public Term {
+    friend class Term;
 public:
     // <<< PUBLIC MEMBERS >>>
     Term_ptr left;          // [4B] << Left member of the product
@@ -187,20 +215,24 @@ private:
     // <<< PRIVATE FUNCTIONS >>>
     unsigned int _MeasureStateSpaceCore();
     SubsumptionResult _IsSubsumedCore(Term* t, bool b = false);
+    template<unsigned Switches>
+    SubsumptionResult _IsSubsumedWith(Term* t, bool b);
 };
 
 /**
  * Class that represents the base states that occurs on the leaf level of the computation
  */
 class TermBaseSet : public Term {
+    friend class Term;
 public:
     // <<< PUBLIC MEMBERS >>>
     TermBaseSetStates states;       // [12B] << Linear Structure with Atomic States
+    BaseSimulation* simulation;     // [8B] << Backward simulation of the base automaton, nullptr if identity
     // See #L29
     TERM_MEASURELIST(DEFINE_STATIC_MEASURE)
 
     // <<< CONSTRUCTORS >>>
-    NEVER_INLINE TermBaseSet(VATA::Util::OrdVector<size_t>&, unsigned int, unsigned int);
+    NEVER_INLINE TermBaseSet(VATA::Util::OrdVector<size_t>&, unsigned int, unsigned int, BaseSimulation* simulation = nullptr);
     NEVER_INLINE ~TermBaseSet();
 
     // <<< PUBLIC API >>>
@@ -217,6 +249,8 @@ private:
     // <<< PRIVATE FUNCTIONS >>>
     unsigned int _MeasureStateSpaceCore();
     SubsumptionResult _IsSubsumedCore(Term* t, bool b = false);
+    template<unsigned Switches>
+    SubsumptionResult _IsSubsumedWith(Term* t, bool b);
 };
 
 /**
@@ -292,6 +326,7 @@ private:
  * Class representing the fixpoint computation (either classic or pre fixpoint computation)
  */
 class TermFixpoint : public Term {
+    friend class Term;
     friend class Workshops::TermWorkshop;
     // <<< MEMBERS >>>
 public:
@@ -361,13 +396,7 @@ public:
                         assert(_termFixpoint._sourceIt.get() != nullptr);
                         if ((term = _termFixpoint._sourceIt->GetNext()) != nullptr) {
                             // if more are to be processed
-                            for (auto symbol : _termFixpoint._symList) {
-#                               if (OPT_FIXPOINT_BFS_SEARCH == true)
-                                _termFixpoint._worklist.push_back(std::make_pair(term, symbol));
-#                               else
-                                _termFixpoint._worklist.insert(_termFixpoint._worklist.cbegin(), std::make_pair(term, symbol));
-#                               endif
-                            }
+                            _termFixpoint._PushSymbols(term);
                             _termFixpoint.ComputeNextPre();
                             return this->GetNext();
                         } else {
@@ -400,7 +429,8 @@ public:
 
     // Only for the pre-semantics to link into the source of the pre
 protected:
-    TermCache _subsumedByCache;             // [36B] << Caching of the subsumption testing
+    static TermCacheTable _subsumedByCaches;    // << Caching of the subsumption testing (created on first use)
+    static void (TermFixpoint::*_pushSymbols)(Term_ptr);   // << Instantiation of _EnqueueSymbols for the search order
     std::shared_ptr<iterator> _sourceIt;    // [8B] << Source iterator of the pre fixpoint
     FixpointType _fixpoint;                 // [8B] << Fixpoint structure of terms
     TermListType _postponed;                // [8B] << Worklist with postponed terms
@@ -415,6 +445,7 @@ protected:
     WorklistSearchType _searchType;         // [4B] << Search type for Worklist
     bool _bValue;                           // [1B] << Boolean value of the fixpoint testing
     bool _updated = false;                  // [1B] << Flag if the fixpoint was updated during the last unique check
+    bool _hasSubsumedByCache = false;       // [1B] << Fixpoint has the cache in _subsumedByCaches
 
 public:
     // << STATIC MEASURES >>
@@ -469,7 +500,31 @@ protected:
     bool _eqCore(const Term&);
     unsigned int _MeasureStateSpaceCore();
     WorklistItemType _popFromWorklist();
+    template<bool BreadthFirst>
+    void _EnqueueSymbols(Term_ptr term);
+    void _PushSymbols(Term_ptr term);
 };
 
+/**
+ * Pushes the pairs (term, symbol) for all symbols of the fixpoint to the worklist. The search order is resolved
+ * during the compilation, so there is no branching in the loop.
+ *
+ * @param[in] term:     term, whose pre will be computed
+ */
+template<bool BreadthFirst>
+inline void TermFixpoint::_EnqueueSymbols(Term_ptr term) {
+    for(auto& symbol : this->_symList) {
+        if(BreadthFirst) {
+            this->_worklist.push_back(std::make_pair(term, symbol));
+        } else {
+            this->_worklist.insert(this->_worklist.cbegin(), std::make_pair(term, symbol));
+        }
+    }
+}
+
+inline void TermFixpoint::_PushSymbols(Term_ptr term) {
+    (this->*TermFixpoint::_pushSymbols)(term);
+}
+
 #undef DEFINE_STATIC_MEASURE
 #endif //WSKS_TERM_H
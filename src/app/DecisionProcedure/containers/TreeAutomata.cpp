@@ -0,0 +1,393 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: TreeAutomata.cpp
+ *  Description:
+ *      Symbolic tree automata for deciding WS2S.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <boost/functional/hash.hpp>
+#include "TreeAutomata.h"
+#include "../../Frontend/symboltable.h"
+
+extern SymbolTable symbolTable;
+extern VarToTrackMap varMap;
+
+// <<< TERM FACTORY >>>
+
+TreeTermFactory::~TreeTermFactory() {
+    for(TreeTerm* term : this->_terms) {
+        delete term;
+    }
+}
+
+bool TreeTermFactory::TermEqual::operator()(const TreeTerm* lhs, const TreeTerm* rhs) const {
+    if(lhs->kind != rhs->kind || lhs->hash != rhs->hash) {
+        return false;
+    }
+    switch(lhs->kind) {
+        case TreeTerm::BASE:
+            return lhs->state == rhs->state;
+        case TreeTerm::PRODUCT:
+            return lhs->left == rhs->left && lhs->right == rhs->right;
+        default:
+            return lhs->elements == rhs->elements;
+    }
+}
+
+/**
+ * Returns the unique instance of the @p term, the @p term is deleted if it was already created
+ *
+ * @param[in] term:     newly created term
+ * @return:             unique instance of the term
+ */
+const TreeTerm* TreeTermFactory::_Intern(TreeTerm* term) {
+    auto inserted = this->_terms.insert(term);
+    if(!inserted.second) {
+        delete term;
+    }
+    return *inserted.first;
+}
+
+const TreeTerm* TreeTermFactory::CreateBase(State q) {
+    TreeTerm* term = new TreeTerm();
+    term->kind = TreeTerm::BASE;
+    term->state = q;
+    term->hash = boost::hash_value(q);
+    return this->_Intern(term);
+}
+
+const TreeTerm* TreeTermFactory::CreateProduct(const TreeTerm* left, const TreeTerm* right) {
+    TreeTerm* term = new TreeTerm();
+    term->kind = TreeTerm::PRODUCT;
+    term->left = left;
+    term->right = right;
+    term->hash = 0;
+    boost::hash_combine(term->hash, left);
+    boost::hash_combine(term->hash, right);
+    return this->_Intern(term);
+}
+
+/**
+ * @param[in] elements:     antichain of the terms, that is sorted and moved to the created term
+ * @return:                 unique instance of the set of the @p elements
+ */
+const TreeTerm* TreeTermFactory::CreateSet(std::vector<const TreeTerm*>& elements) {
+    TreeTerm* term = new TreeTerm();
+    term->kind = TreeTerm::SET;
+    std::sort(elements.begin(), elements.end());
+    term->elements.swap(elements);
+    term->hash = boost::hash_range(term->elements.begin(), term->elements.end());
+    return this->_Intern(term);
+}
+
+// <<< TREE AUTOMATON >>>
+
+size_t TreeAutomaton::PostKeyHash::operator()(const std::tuple<SsId, const TreeTerm*, const TreeTerm*, TreeSymbol>& key) const {
+    size_t seed = boost::hash_value(std::get<0>(key));
+    boost::hash_combine(seed, std::get<1>(key));
+    boost::hash_combine(seed, std::get<2>(key));
+    boost::hash_combine(seed, std::get<3>(key));
+    return seed;
+}
+
+/**
+ * Returns the term reached in the leaves of the state space @p d, the terms are computed for all of the state spaces
+ * at once
+ *
+ * @param[in] d:    state space of the guide
+ * @return:         initial term of the state space
+ */
+const TreeTerm* TreeAutomaton::GetInitial(SsId d) {
+    if(this->_initial.empty()) {
+        this->_InitializeInitial();
+        assert(this->_initial.size() == guide.numSs);
+    }
+    return this->_initial[d];
+}
+
+/**
+ * Returns the term reached in the state space @p d from the terms of the children over the @p symbol
+ *
+ * @param[in] d:        state space of the node
+ * @param[in] left:     term of the left child (in the left successor of @p d)
+ * @param[in] right:    term of the right child (in the right successor of @p d)
+ * @param[in] symbol:   symbol of the node
+ * @return:             term of the node
+ */
+const TreeTerm* TreeAutomaton::Post(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol) {
+    auto key = std::make_tuple(d, left, right, symbol);
+    auto it = this->_postCache.find(key);
+    if(it != this->_postCache.end()) {
+        return it->second;
+    }
+
+    const TreeTerm* result = this->_PostCore(d, left, right, symbol);
+    this->_postCache.emplace(std::move(key), result);
+    return result;
+}
+
+/**
+ * @return: true if the language of the @p lhs is subsumed by the language of the @p rhs
+ */
+bool TreeAutomaton::IsSubsumed(const TreeTerm* lhs, const TreeTerm* rhs) {
+    return lhs == rhs || this->_IsSubsumedCore(lhs, rhs);
+}
+
+// <<< BASE AUTOMATON >>>
+
+BaseTreeAutomaton::BaseTreeAutomaton(GTA* gta, ASTForm* form) : TreeAutomaton(AutType::BASE), _gta(gta), _form(form) {}
+
+void BaseTreeAutomaton::_InitializeInitial() {
+    for(SsId d = 0; d < guide.numSs; ++d) {
+        this->_initial.push_back(this->_factory.CreateBase(this->_gta.GetInitialState(d)));
+    }
+}
+
+const TreeTerm* BaseTreeAutomaton::_PostCore(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol) {
+    assert(left->kind == TreeTerm::BASE && right->kind == TreeTerm::BASE);
+    return this->_factory.CreateBase(this->_gta.Post(d, left->state, right->state, symbol));
+}
+
+bool BaseTreeAutomaton::IsFinal(const TreeTerm* term) {
+    assert(term->kind == TreeTerm::BASE);
+    return this->_gta.IsFinal(term->state);
+}
+
+void BaseTreeAutomaton::DumpAutomaton() {
+    std::cout << "TreeAutomaton";
+    this->_form->dump();
+}
+
+// <<< BINARY AUTOMATON >>>
+
+BinaryOpTreeAutomaton::BinaryOpTreeAutomaton(TreeAutomaton* lhs, TreeAutomaton* rhs, AutType t)
+        : TreeAutomaton(t), _lhs(lhs), _rhs(rhs) {
+    assert(t == AutType::INTERSECTION || t == AutType::UNION);
+    this->_lhs->IncReferences();
+    this->_rhs->IncReferences();
+}
+
+BinaryOpTreeAutomaton::~BinaryOpTreeAutomaton() {
+    this->_lhs->DecReferences();
+    this->_rhs->DecReferences();
+}
+
+void BinaryOpTreeAutomaton::_InitializeInitial() {
+    for(SsId d = 0; d < guide.numSs; ++d) {
+        this->_initial.push_back(this->_factory.CreateProduct(this->_lhs->GetInitial(d), this->_rhs->GetInitial(d)));
+    }
+}
+
+const TreeTerm* BinaryOpTreeAutomaton::_PostCore(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol) {
+    assert(left->kind == TreeTerm::PRODUCT && right->kind == TreeTerm::PRODUCT);
+    return this->_factory.CreateProduct(this->_lhs->Post(d, left->left, right->left, symbol),
+                                        this->_rhs->Post(d, left->right, right->right, symbol));
+}
+
+bool BinaryOpTreeAutomaton::_IsSubsumedCore(const TreeTerm* lhs, const TreeTerm* rhs) {
+    return this->_lhs->IsSubsumed(lhs->left, rhs->left) && this->_rhs->IsSubsumed(lhs->right, rhs->right);
+}
+
+bool BinaryOpTreeAutomaton::IsFinal(const TreeTerm* term) {
+    if(this->type == AutType::INTERSECTION) {
+        return this->_lhs->IsFinal(term->left) && this->_rhs->IsFinal(term->right);
+    } else {
+        return this->_lhs->IsFinal(term->left) || this->_rhs->IsFinal(term->right);
+    }
+}
+
+void BinaryOpTreeAutomaton::DumpAutomaton() {
+    const char* colour = (this->type == AutType::INTERSECTION) ? "\033[1;32m" : "\033[1;33m";
+    std::cout << colour << "(\033[0m";
+    this->_lhs->DumpAutomaton();
+    std::cout << colour << ((this->type == AutType::INTERSECTION) ? " \u2229 " : " \u222A ") << "\033[0m";
+    this->_rhs->DumpAutomaton();
+    std::cout << colour << ")\033[0m";
+}
+
+// <<< COMPLEMENT AUTOMATON >>>
+
+ComplementTreeAutomaton::ComplementTreeAutomaton(TreeAutomaton* aut) : TreeAutomaton(AutType::COMPLEMENT), _aut(aut) {
+    this->_aut->IncReferences();
+}
+
+ComplementTreeAutomaton::~ComplementTreeAutomaton() {
+    this->_aut->DecReferences();
+}
+
+void ComplementTreeAutomaton::_InitializeInitial() {
+    for(SsId d = 0; d < guide.numSs; ++d) {
+        this->_initial.push_back(this->_aut->GetInitial(d));
+    }
+}
+
+/**
+ * Complement shares the terms (and the cache of the Post) with its operand
+ */
+const TreeTerm* ComplementTreeAutomaton::Post(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol) {
+    return this->_aut->Post(d, left, right, symbol);
+}
+
+const TreeTerm* ComplementTreeAutomaton::_PostCore(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol) {
+    return this->_aut->Post(d, left, right, symbol);
+}
+
+void ComplementTreeAutomaton::DumpAutomaton() {
+    std::cout << "\033[1;31m\u2201(\033[0m";
+    this->_aut->DumpAutomaton();
+    std::cout << "\033[1;31m)\033[0m";
+}
+
+// <<< PROJECTION AUTOMATON >>>
+
+ProjectionTreeAutomaton::ProjectionTreeAutomaton(TreeAutomaton* aut, IdentList* vars)
+        : TreeAutomaton(AutType::PROJECTION), _aut(aut), _vars(vars->copy()) {
+    this->_aut->IncReferences();
+    for(auto it = vars->begin(); it != vars->end(); ++it) {
+        this->_tracks.push_back(varMap[*it]);
+    }
+}
+
+ProjectionTreeAutomaton::~ProjectionTreeAutomaton() {
+    this->_aut->DecReferences();
+    delete this->_vars;
+}
+
+/**
+ * Inserts the @p term to the @p antichain, unless it is subsumed by some of its elements. Elements subsumed by the
+ * @p term are removed.
+ *
+ * @param[in,out] antichain:    antichain of the terms of the operand
+ * @param[in] term:             inserted term
+ * @return:                     true if the @p term was inserted
+ */
+bool ProjectionTreeAutomaton::_InsertMaximal(std::vector<const TreeTerm*>& antichain, const TreeTerm* term) {
+    for(const TreeTerm* element : antichain) {
+        if(this->_aut->IsSubsumed(term, element)) {
+            return false;
+        }
+    }
+    antichain.erase(std::remove_if(antichain.begin(), antichain.end(), [this, term](const TreeTerm* element) {
+        return this->_aut->IsSubsumed(element, term);
+    }), antichain.end());
+    antichain.push_back(term);
+    return true;
+}
+
+/**
+ * Inserts the Post of the operand over all of the values of the projected tracks of the @p symbol to the antichain
+ * @p result
+ *
+ * @param[in] d:            state space of the node
+ * @param[in] left:         term of the operand in the left child
+ * @param[in] right:        term of the operand in the right child
+ * @param[in] symbol:       symbol of the node (the projected tracks are ignored)
+ * @param[in,out] result:   antichain of the terms of the operand
+ * @return:                 true if some term was inserted to the @p result
+ */
+bool ProjectionTreeAutomaton::_PostOverProjected(SsId d, const TreeTerm* left, const TreeTerm* right,
+                                                 const TreeSymbol& symbol, std::vector<const TreeTerm*>& result) {
+    bool inserted = false;
+    TreeSymbol value(symbol);
+    size_t valuesNo = static_cast<size_t>(1) << this->_tracks.size();
+    for(size_t bits = 0; bits < valuesNo; ++bits) {
+        for(size_t i = 0; i < this->_tracks.size(); ++i) {
+            value[this->_tracks[i]] = ((bits >> i) & 1) ? '1' : '0';
+        }
+        inserted |= this->_InsertMaximal(result, this->_aut->Post(d, left, right, value));
+    }
+    return inserted;
+}
+
+/**
+ * Computes the initial terms as the least fixpoint: leaves of the state space reach the initial terms of the operand
+ * and any node, that is zero on the outer tracks, reaches the Post of the terms reached in its children. The state
+ * spaces of the guide depend on each other, hence the fixpoint is computed for all of them at once.
+ */
+void ProjectionTreeAutomaton::_InitializeInitial() {
+    std::vector<std::vector<const TreeTerm*>> reached(guide.numSs);
+    for(SsId d = 0; d < guide.numSs; ++d) {
+        reached[d].push_back(this->_aut->GetInitial(d));
+    }
+
+    TreeSymbol zero(varMap.TrackLength(), '0');
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        for(SsId d = 0; d < guide.numSs; ++d) {
+            // Copies, since the antichain of the successor can be the updated one
+            std::vector<const TreeTerm*> lefts(reached[guide.muLeft[d]]);
+            std::vector<const TreeTerm*> rights(reached[guide.muRight[d]]);
+            for(const TreeTerm* left : lefts) {
+                for(const TreeTerm* right : rights) {
+                    changed |= this->_PostOverProjected(d, left, right, zero, reached[d]);
+                }
+            }
+        }
+    }
+
+    for(SsId d = 0; d < guide.numSs; ++d) {
+        this->_initial.push_back(this->_factory.CreateSet(reached[d]));
+    }
+}
+
+const TreeTerm* ProjectionTreeAutomaton::_PostCore(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol) {
+    assert(left->kind == TreeTerm::SET && right->kind == TreeTerm::SET);
+    std::vector<const TreeTerm*> result;
+    for(const TreeTerm* l : left->elements) {
+        for(const TreeTerm* r : right->elements) {
+            this->_PostOverProjected(d, l, r, symbol, result);
+        }
+    }
+    return this->_factory.CreateSet(result);
+}
+
+/**
+ * @return: true if each of the elements of the @p lhs is subsumed by some element of the @p rhs
+ */
+bool ProjectionTreeAutomaton::_IsSubsumedCore(const TreeTerm* lhs, const TreeTerm* rhs) {
+    for(const TreeTerm* l : lhs->elements) {
+        bool isSubsumed = false;
+        for(const TreeTerm* r : rhs->elements) {
+            if(this->_aut->IsSubsumed(l, r)) {
+                isSubsumed = true;
+                break;
+            }
+        }
+        if(!isSubsumed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ProjectionTreeAutomaton::IsFinal(const TreeTerm* term) {
+    for(const TreeTerm* element : term->elements) {
+        if(this->_aut->IsFinal(element)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ProjectionTreeAutomaton::DumpAutomaton() {
+    std::cout << "\033[1;34m\u2203";
+    for(auto it = this->_vars->begin(); it != this->_vars->end(); ++it) {
+        std::cout << symbolTable.lookupSymbol(*it);
+        if((it + 1) != this->_vars->end()) {
+            std::cout << ", ";
+        }
+    }
+    std::cout << "(\033[0m";
+    this->_aut->DumpAutomaton();
+    std::cout << "\033[1;34m)\033[0m";
+}
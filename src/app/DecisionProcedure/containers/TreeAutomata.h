@@ -0,0 +1,227 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: TreeAutomata.h
+ *  Description:
+ *      Symbolic tree automata for deciding WS2S. Analogously to the WS1S
+ *      symbolic automata, the automaton is the tree of the (lazily
+ *      evaluated) boolean operations and projections over base automata
+ *      constructed by MONA (as GTAs). The automata are deterministic and
+ *      bottom-up: the states are terms, that are computed on demand, for
+ *      each state space of the guide, by the Post over the pair of terms
+ *      of the children and the symbol.
+ *
+ *      Projection is the subset construction: its terms are the sets of
+ *      the operand terms, kept as antichains of the maximal elements wrt
+ *      the subsumption. Its initial term is the least fixpoint of the Post
+ *      over the symbols with zero on the outer tracks (i.e. the padding of
+ *      the tree by the nodes, that can be labeled on the projected tracks
+ *      only). Unlike the WS1S projection, the fixpoint is computed eagerly
+ *      as a whole, and no (counter)examples are reconstructed.
+ *****************************************************************************/
+
+#ifndef WSKS_TREEAUTOMATA_H
+#define WSKS_TREEAUTOMATA_H
+
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../../Frontend/ast.h"
+#include "../mtbdd/gtawrapper.hh"
+#include "../environment.hh"
+
+using TreeSymbol = std::string;   // << Values ('0'/'1') of the tracks, indexed by the track
+
+/**
+ * State of the tree automaton. Terms are hash-consed by the factory of the automaton, so the equal terms have the
+ * same address.
+ */
+struct TreeTerm {
+    enum Kind {BASE, PRODUCT, SET};
+
+    Kind kind;
+    State state;                                // << State of the base automaton
+    const TreeTerm* left;                       // << Components of the product
+    const TreeTerm* right;
+    std::vector<const TreeTerm*> elements;      // << Antichain of the projection, ordered by the addresses
+    size_t hash;
+};
+
+class TreeTermFactory {
+public:
+    // <<< PUBLIC CONSTRUCTORS AND DESTRUCTORS >>>
+    TreeTermFactory() {}
+    ~TreeTermFactory();
+
+    TreeTermFactory(const TreeTermFactory&) = delete;
+    TreeTermFactory& operator=(const TreeTermFactory&) = delete;
+
+    // <<< PUBLIC API >>>
+    const TreeTerm* CreateBase(State q);
+    const TreeTerm* CreateProduct(const TreeTerm* left, const TreeTerm* right);
+    const TreeTerm* CreateSet(std::vector<const TreeTerm*>& elements);
+    size_t Size() const { return this->_terms.size(); }
+
+private:
+    struct TermHash {
+        size_t operator()(const TreeTerm* t) const { return t->hash; }
+    };
+    struct TermEqual {
+        bool operator()(const TreeTerm* lhs, const TreeTerm* rhs) const;
+    };
+
+    // <<< PRIVATE MEMBERS >>>
+    std::unordered_set<TreeTerm*, TermHash, TermEqual> _terms;
+
+    // <<< PRIVATE METHODS >>>
+    const TreeTerm* _Intern(TreeTerm* term);
+};
+
+/**
+ * Base class of the symbolic tree automata
+ */
+class TreeAutomaton {
+public:
+    // <<< PUBLIC MEMBERS >>>
+    AutType type;
+
+    // <<< PUBLIC CONSTRUCTORS AND DESTRUCTORS >>>
+    explicit TreeAutomaton(AutType t) : type(t), _refs(0) {}
+    virtual ~TreeAutomaton() {}
+
+    void IncReferences() {++this->_refs;}
+    void DecReferences() {assert(this->_refs > 0); --this->_refs; if(this->_refs < 1) delete this;}
+
+    // <<< PUBLIC API >>>
+    const TreeTerm* GetInitial(SsId d);
+    virtual const TreeTerm* Post(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol);
+    bool IsSubsumed(const TreeTerm* lhs, const TreeTerm* rhs);
+    virtual bool IsFinal(const TreeTerm* term) = 0;
+
+    // <<< DUMPING FUNCTIONS >>>
+    virtual void DumpAutomaton() = 0;
+    virtual unsigned int CountNodes() = 0;
+
+protected:
+    struct PostKeyHash {
+        size_t operator()(const std::tuple<SsId, const TreeTerm*, const TreeTerm*, TreeSymbol>& key) const;
+    };
+    using PostCache = std::unordered_map<std::tuple<SsId, const TreeTerm*, const TreeTerm*, TreeSymbol>,
+                                         const TreeTerm*, PostKeyHash>;
+
+    // <<< PRIVATE MEMBERS >>>
+    size_t _refs;
+    TreeTermFactory _factory;
+    std::vector<const TreeTerm*> _initial;      // << Initial term of each of the state spaces
+    PostCache _postCache;
+
+    // <<< PRIVATE METHODS >>>
+    virtual void _InitializeInitial() = 0;
+    virtual const TreeTerm* _PostCore(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol) = 0;
+    virtual bool _IsSubsumedCore(const TreeTerm* lhs, const TreeTerm* rhs) = 0;
+};
+
+/**
+ * Base automaton constructed by MONA
+ */
+class BaseTreeAutomaton : public TreeAutomaton {
+public:
+    BaseTreeAutomaton(GTA* gta, ASTForm* form);
+
+    virtual bool IsFinal(const TreeTerm* term);
+    virtual void DumpAutomaton();
+    virtual unsigned int CountNodes() { return 1; }
+
+protected:
+    // <<< PRIVATE MEMBERS >>>
+    GtaWrapper _gta;
+    ASTForm* _form;
+
+    // <<< PRIVATE METHODS >>>
+    virtual void _InitializeInitial();
+    virtual const TreeTerm* _PostCore(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol);
+    virtual bool _IsSubsumedCore(const TreeTerm* lhs, const TreeTerm* rhs) { return false; }
+};
+
+/**
+ * Product of the automata, i.e. intersection or union
+ */
+class BinaryOpTreeAutomaton : public TreeAutomaton {
+public:
+    BinaryOpTreeAutomaton(TreeAutomaton* lhs, TreeAutomaton* rhs, AutType t);
+    virtual ~BinaryOpTreeAutomaton();
+
+    virtual bool IsFinal(const TreeTerm* term);
+    virtual void DumpAutomaton();
+    virtual unsigned int CountNodes() { return 1 + this->_lhs->CountNodes() + this->_rhs->CountNodes(); }
+
+protected:
+    // <<< PRIVATE MEMBERS >>>
+    TreeAutomaton* _lhs;
+    TreeAutomaton* _rhs;
+
+    // <<< PRIVATE METHODS >>>
+    virtual void _InitializeInitial();
+    virtual const TreeTerm* _PostCore(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol);
+    virtual bool _IsSubsumedCore(const TreeTerm* lhs, const TreeTerm* rhs);
+};
+
+/**
+ * Complement of the automaton. Automata are deterministic, so only the finality of the terms is flipped (together
+ * with the subsumption).
+ */
+class ComplementTreeAutomaton : public TreeAutomaton {
+public:
+    explicit ComplementTreeAutomaton(TreeAutomaton* aut);
+    virtual ~ComplementTreeAutomaton();
+
+    virtual const TreeTerm* Post(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol);
+    virtual bool IsFinal(const TreeTerm* term) { return !this->_aut->IsFinal(term); }
+    virtual void DumpAutomaton();
+    virtual unsigned int CountNodes() { return 1 + this->_aut->CountNodes(); }
+
+protected:
+    // <<< PRIVATE MEMBERS >>>
+    TreeAutomaton* _aut;
+
+    // <<< PRIVATE METHODS >>>
+    virtual void _InitializeInitial();
+    virtual const TreeTerm* _PostCore(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol);
+    virtual bool _IsSubsumedCore(const TreeTerm* lhs, const TreeTerm* rhs) { return this->_aut->IsSubsumed(rhs, lhs); }
+};
+
+/**
+ * Projection of the tracks of the automaton
+ */
+class ProjectionTreeAutomaton : public TreeAutomaton {
+public:
+    ProjectionTreeAutomaton(TreeAutomaton* aut, IdentList* vars);
+    virtual ~ProjectionTreeAutomaton();
+
+    virtual bool IsFinal(const TreeTerm* term);
+    virtual void DumpAutomaton();
+    virtual unsigned int CountNodes() { return 1 + this->_aut->CountNodes(); }
+
+protected:
+    // <<< PRIVATE MEMBERS >>>
+    TreeAutomaton* _aut;
+    IdentList* _vars;                           // << Projected variables
+    std::vector<unsigned int> _tracks;          // << Tracks of the projected variables
+
+    // <<< PRIVATE METHODS >>>
+    virtual void _InitializeInitial();
+    virtual const TreeTerm* _PostCore(SsId d, const TreeTerm* left, const TreeTerm* right, const TreeSymbol& symbol);
+    virtual bool _IsSubsumedCore(const TreeTerm* lhs, const TreeTerm* rhs);
+    bool _PostOverProjected(SsId, const TreeTerm*, const TreeTerm*, const TreeSymbol&, std::vector<const TreeTerm*>&);
+    bool _InsertMaximal(std::vector<const TreeTerm*>& antichain, const TreeTerm* term);
+};
+
+#endif //WSKS_TREEAUTOMATA_H
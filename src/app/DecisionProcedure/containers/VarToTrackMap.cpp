@@ -12,12 +12,16 @@
 #include "../../Frontend/symboltable.h"
 #include "../../Frontend/offsets.h"
 
+#include <algorithm>
 #include <iostream>
 
 extern SymbolTable symbolTable;
 extern Offsets offsets;
 extern Ident allPosVar;
 
+// Bound by reference in resize()/assign(), hence it needs the definition
+const unsigned int VarToTrackMap::Unmapped;
+
 /**
  * Private Methods
  */
@@ -26,17 +30,29 @@ extern Ident allPosVar;
  * Adds variables from list to the map
  *
  * @param identifiers: list of variables
+ * @param keepOrder: if true, the tracks are assigned in the order of the list, otherwise by identifiers
  */
-void VarToTrackMap::addIdentifiers(IdentList* identifiers) {
+void VarToTrackMap::addIdentifiers(IdentList* identifiers, bool keepOrder) {
 	uint identSize = identifiers->size();
-	identifiers->sort();
+	if(!keepOrder) {
+		identifiers->sort();
+	}
+
+	// The map is indexed directly by the variables, so we make room for the greatest one
+	uint maxIdent = 0;
+	for(auto it = identifiers->begin(); it != identifiers->end(); ++it) {
+		maxIdent = std::max(maxIdent, static_cast<uint>(*it));
+	}
+	if(this->vttMap.size() <= maxIdent) {
+		this->vttMap.resize(maxIdent + 1, Unmapped);
+	}
 
-	size_t idx = 0;
+	size_t idx = this->ttvMap.size();
 	Ident formal;
 	ASTForm* restriction = nullptr;
 	for (int i = 0; i < identSize; ++i) {
 		// Fixme: there should be some shit with restrictions
-		uint val = identifiers->pop_front();
+		uint val = identifiers->get(i);
 		if(symbolTable.lookupType(val) == MonaTypeTag::Varname1) {
 			restriction = symbolTable.getDefault1Restriction(&formal);
 		} else if (symbolTable.lookupType(val) == MonaTypeTag::Varname2) {
@@ -63,8 +79,8 @@ void VarToTrackMap::addIdentifiers(IdentList* identifiers) {
 				continue;
 		}
 
-		(this->vttMap)[val] = idx;
-		(this->ttvMap)[idx++] = val;
+		(this->vttMap)[val] = idx++;
+		this->ttvMap.push_back(val);
 	}
 
 #   if(DEBUG_VARMAP == true)
@@ -73,6 +89,34 @@ void VarToTrackMap::addIdentifiers(IdentList* identifiers) {
 #   endif
 }
 
+/**
+ * Permutes the MONA offsets of the mapped variables, so the order of BDD indices corresponds to the order of
+ * tracks. The wrapped MONA BDDs are traversed track by track, so the two orders have to agree. Only the offsets
+ * of mapped variables are permuted among themselves, so the offsets stay unique.
+ */
+void VarToTrackMap::reorderOffsets() {
+	std::vector<int> used;
+	used.reserve(this->ttvMap.size());
+	for(auto var : this->ttvMap) {
+		used.push_back(offsets.off(var));
+	}
+	std::sort(used.begin(), used.end());
+
+	for(size_t track = 0; track < this->ttvMap.size(); ++track) {
+		offsets.set(this->ttvMap[track], used[track]);
+	}
+}
+
+/**
+ * Initializes the map from BDD indices to tracks, that is used during the traversal of the MONA automata
+ */
+void VarToTrackMap::initializeIndices() {
+	this->ittMap.assign(offsets.maxOffset() + 1, Unmapped);
+	for(size_t track = 0; track < this->ttvMap.size(); ++track) {
+		this->ittMap[offsets.off(this->ttvMap[track])] = track;
+	}
+}
+
 /**
  * Public Methods
  */
@@ -81,7 +125,7 @@ void VarToTrackMap::addIdentifiers(IdentList* identifiers) {
  * @return: Lenght of the track
  */
 uint VarToTrackMap::TrackLength() {
-	return this->vttMap.size();
+	return this->ttvMap.size();
 }
 
 /**
@@ -93,12 +137,21 @@ uint VarToTrackMap::operator[](uint val) {
 	return this->vttMap[val];
 }
 
+/**
+ * @param[in] index: index of the variable in the MONA BDD
+ * @return: track number associated to the BDD index
+ */
+uint VarToTrackMap::TrackOfIndex(uint index) {
+	assert(index < this->ittMap.size() && this->ittMap[index] != Unmapped);
+	return this->ittMap[index];
+}
+
 bool VarToTrackMap::IsIn(uint val) {
-	return this->vttMap.find(val) != this->vttMap.end();
+	return val < this->vttMap.size() && this->vttMap[val] != Unmapped;
 }
 
 uint VarToTrackMap::inverseGet(uint key) {
-	assert(false && "Currently disabled functionality");
+	assert(key < this->ttvMap.size());
 	return this->ttvMap[key];
 }
 
@@ -106,8 +159,9 @@ uint VarToTrackMap::inverseGet(uint key) {
  * Prints var -> trackNo map
  */
 void VarToTrackMap::dumpMap() {
-	for (auto it = this->vttMap.begin(); it != vttMap.end(); ++it) {
-		std::cout << it->first << "(" << symbolTable.lookupSymbol(it->first) << ") -> " << it->second << '\n';
+	for (size_t track = 0; track < this->ttvMap.size(); ++track) {
+		uint var = this->ttvMap[track];
+		std::cout << var << "(" << symbolTable.lookupSymbol(var) << ") -> " << track << '\n';
 	}
 }
 
@@ -118,7 +172,47 @@ void VarToTrackMap::dumpMap() {
  * @param usedVar: list of variables used for track
  */
 void VarToTrackMap::initializeFromList(IdentList* usedVar) {
-	this->addIdentifiers(usedVar);
+	this->addIdentifiers(usedVar, false);
+	this->initializeIndices();
+}
+
+/**
+ * Constructs a mapping from variables to track, where the tracks follow the order of variables in the
+ * @p orderedVars. The MONA offsets are permuted accordingly, so the automata are constructed with the same
+ * order of BDD variables.
+ *
+ * @param orderedVars: list of variables in the order of the tracks
+ */
+void VarToTrackMap::initializeFromOrder(IdentList* orderedVars) {
+	this->addIdentifiers(orderedVars, true);
+	this->reorderOffsets();
+	this->initializeIndices();
+}
+
+/**
+ * Removes all of the mapped variables, so the map can be initialized for another formula
+ */
+void VarToTrackMap::clear() {
+	this->vttMap.clear();
+	this->ttvMap.clear();
+	this->ittMap.clear();
+}
+
+/**
+ * Places the variable @p var on the already used @p track. The variable gets the MONA offset of the variable on
+ * the track, so the BDD indices agree with the tracks. This is sound only if the scopes of the two variables are
+ * disjoint (e.g. bound variables of different conjuncts).
+ *
+ * @param var: variable we are placing
+ * @param track: track of the variable
+ */
+void VarToTrackMap::alias(uint var, uint track) {
+	assert(track < this->ttvMap.size());
+	if(this->vttMap.size() <= var) {
+		this->vttMap.resize(var + 1, Unmapped);
+	}
+	this->vttMap[var] = track;
+	offsets.set(var, offsets.off(this->ttvMap[track]));
 }
 
 /**
@@ -127,6 +221,7 @@ void VarToTrackMap::initializeFromList(IdentList* usedVar) {
  */
 void VarToTrackMap::initializeFromLists(IdentList* prefixVars, IdentList* matrixVars) {
 	assert(false);
-	this->addIdentifiers(prefixVars);
-	this->addIdentifiers(matrixVars);
+	this->addIdentifiers(prefixVars, false);
+	this->addIdentifiers(matrixVars, false);
+	this->initializeIndices();
 }
@@ -11,7 +11,7 @@
 #ifndef __VAR_TO_TRACK_MAP__
 #define __VAR_TO_TRACK_MAP__
 
-#include <map>
+#include <vector>
 
 #include "../../Frontend/ident.h"
 #include "../environment.hh"
@@ -20,19 +20,24 @@ class VarToTrackMap {
 private:
 	// < Typedefs >
 	typedef unsigned int uint;
-	typedef std::map<uint, uint> varMap;
+	typedef std::vector<uint> varMap;
 
 	// < Private Members >
-	varMap vttMap;
-	varMap ttvMap;
+	static const uint Unmapped = static_cast<uint>(-1);
+	varMap vttMap;		// < variable -> track
+	varMap ttvMap;		// < track -> variable
+	varMap ittMap;		// < BDD index (i.e. MONA offset) -> track
 
 	// < Private Methods >
-	void addIdentifiers(IdentList* );
+	void addIdentifiers(IdentList*, bool);
+	void reorderOffsets();
+	void initializeIndices();
 
 public:
 	// < Public Methods >
 	uint TrackLength();
 	uint operator[](uint);
+	uint TrackOfIndex(uint);
 	uint inverseGet(uint);
 	void dumpMap();
 	bool IsIn(uint);
@@ -40,7 +45,10 @@ public:
 	VarToTrackMap() : vttMap() {};
 
 	void initializeFromList(IdentList*);
+	void initializeFromOrder(IdentList*);
 	void initializeFromLists(IdentList*, IdentList*);
+	void clear();
+	void alias(uint var, uint track);
 };
 
 #endif
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "Workshops.h"
 #include "Term.h"
 #include "VarToTrackMap.hh"
@@ -8,10 +9,12 @@ namespace Workshops {
     NEVER_INLINE TermWorkshop::TermWorkshop(SymbolicAutomaton* aut) :
             _bCache(nullptr), _pCache(nullptr), _lCache(nullptr), _fpCache(nullptr), _fppCache(nullptr),
             _contCache(nullptr),
-            _compCache(nullptr), _aut(aut) { }
+            _compCache(nullptr), _aut(aut) {
+        TermWorkshop::_workshops.insert(this);
+    }
 
-    template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&)>
-    BinaryCache<A, B, C, D, E, F>* TermWorkshop::_cleanCache(BinaryCache<A, B, C, D, E, F>* cache, bool noMemberDelete) {
+    template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&), Gaston::Memory::Category G>
+    BinaryCache<A, B, C, D, E, F, G>* TermWorkshop::_cleanCache(BinaryCache<A, B, C, D, E, F, G>* cache, bool noMemberDelete) {
         if(cache != nullptr) {
             if(!noMemberDelete) {
                 for (auto it = cache->begin(); it != cache->end(); ++it) {
@@ -32,15 +35,8 @@ namespace Workshops {
         this->_lCache = TermWorkshop::_cleanCache(this->_lCache);
         this->_contCache = TermWorkshop::_cleanCache(this->_contCache);
         this->_compCache = TermWorkshop::_cleanCache(this->_compCache, true);
-
-        if(TermWorkshop::_empty != nullptr) {
-            delete TermWorkshop::_empty;
-            TermWorkshop::_empty = nullptr;
-        }
-        if(TermWorkshop::_emptyComplement != nullptr) {
-            delete TermWorkshop::_emptyComplement;
-            TermWorkshop::_emptyComplement = nullptr;
-        }
+        // Note: the empty terms are shared by all of the workshops, they are released by ReleaseEmpty()
+        TermWorkshop::_workshops.erase(this);
     }
 
     // ComputationKey    = std::pair<FixpointType*, WorklistType*>;
@@ -162,6 +158,9 @@ namespace Workshops {
 
     TermEmpty* TermWorkshop::_empty = nullptr;
     TermEmpty* TermWorkshop::_emptyComplement = nullptr;
+    std::unordered_set<TermWorkshop*> TermWorkshop::_workshops;
+    size_t TermWorkshop::_createdTerms = 0;
+    size_t TermWorkshop::_liveTerms = 0;
 
     TermEmpty* TermWorkshop::CreateEmpty() {
         if(TermWorkshop::_empty == nullptr) {
@@ -179,6 +178,234 @@ namespace Workshops {
         return TermWorkshop::_emptyComplement;
     }
 
+    /**
+     * Releases the shared empty terms, may be called only when no automaton that could refer them is alive
+     */
+    void TermWorkshop::ReleaseEmpty() {
+        if(TermWorkshop::_empty != nullptr) {
+            delete TermWorkshop::_empty;
+            TermWorkshop::_empty = nullptr;
+        }
+        if(TermWorkshop::_emptyComplement != nullptr) {
+            delete TermWorkshop::_emptyComplement;
+            TermWorkshop::_emptyComplement = nullptr;
+        }
+    }
+
+    namespace {
+        using MarkedTerms = std::unordered_set<const Term*>;
+
+        void pushUnmarked(Term* term, MarkedTerms& marked, std::vector<Term*>& worklist) {
+            if(term != nullptr && !marked.count(term)) {
+                worklist.push_back(term);
+            }
+        }
+
+        // Terms occuring in the keys of the caches
+        void pushKeyTerms(Term* key, MarkedTerms& marked, std::vector<Term*>& worklist) {
+            pushUnmarked(key, marked, worklist);
+        }
+
+        void pushKeyTerms(const ProductKey& key, MarkedTerms& marked, std::vector<Term*>& worklist) {
+            pushUnmarked(key.first, marked, worklist);
+            pushUnmarked(key.second, marked, worklist);
+        }
+
+        void pushKeyTerms(const FixpointKey& key, MarkedTerms& marked, std::vector<Term*>& worklist) {
+            pushUnmarked(key.first, marked, worklist);
+        }
+    }
+
+    /**
+     * @return: true if enough terms were created since the last collection, so it pays off to collect them
+     */
+    bool TermWorkshop::ShouldCollectGarbage() {
+        return TermWorkshop::_createdTerms >= std::max<size_t>(TERM_GC_MIN_TERMS, TermWorkshop::_liveTerms);
+    }
+
+    /**
+     * Resets the counters of the collection, so the terms of the previous formula do not postpone (or trigger) the
+     * collection of the next one
+     */
+    void TermWorkshop::ResetGarbageCounters() {
+        TermWorkshop::_createdTerms = 0;
+        TermWorkshop::_liveTerms = 0;
+    }
+
+    /**
+     * Marks the terms in @p worklist and all of the terms reachable from them
+     *
+     * @param[in,out] worklist:     terms to be marked
+     * @param[in,out] marked:       already marked terms
+     */
+    void TermWorkshop::_MarkReachable(std::vector<Term*>& worklist, TermSet& marked) {
+        while(!worklist.empty()) {
+            Term* term = worklist.back();
+            worklist.pop_back();
+            if(term == nullptr || !marked.insert(term).second) {
+                continue;
+            }
+
+            worklist.push_back(term->link.succ);
+            switch(term->type) {
+                case TERM_PRODUCT:
+                    worklist.push_back(static_cast<TermProduct*>(term)->left);
+                    worklist.push_back(static_cast<TermProduct*>(term)->right);
+                    break;
+                case TERM_LIST:
+                    for(Term* item : static_cast<TermList*>(term)->list) {
+                        worklist.push_back(item);
+                    }
+                    break;
+                case TERM_CONTINUATION:
+                    worklist.push_back(static_cast<TermContinuation*>(term)->term);
+                    worklist.push_back(static_cast<TermContinuation*>(term)->GetUnfoldedTerm());
+                    break;
+                case TERM_FIXPOINT: {
+                    TermFixpoint* fixpoint = static_cast<TermFixpoint*>(term);
+                    for(auto& item : fixpoint->_fixpoint) {
+                        worklist.push_back(item.first);
+                    }
+                    for(auto& item : fixpoint->_worklist) {
+                        worklist.push_back(item.first);
+                    }
+                    for(auto& item : fixpoint->_postponed) {
+                        worklist.push_back(item.first);
+                        worklist.push_back(item.second);
+                    }
+                    worklist.push_back(fixpoint->_sourceTerm);
+                    worklist.push_back(fixpoint->_satTerm);
+                    worklist.push_back(fixpoint->_unsatTerm);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    /**
+     * Pushes the terms in keys of @p cache, whose data are marked, to the @p worklist, as the unique terms are
+     * looked up (and compared) by them.
+     */
+    template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&), Gaston::Memory::Category G>
+    void TermWorkshop::_MarkCacheKeys(BinaryCache<A, B, C, D, E, F, G>* cache, TermSet& marked, std::vector<Term*>& worklist) {
+        if(cache != nullptr) {
+            for(auto it = cache->begin(); it != cache->end(); ++it) {
+                if(marked.count(it->second)) {
+                    pushKeyTerms(it->first, marked, worklist);
+                }
+            }
+        }
+    }
+
+    /**
+     * Marks the results cached for the marked terms and the keys of the marked unique terms
+     *
+     * @param[in] marked:       already marked terms
+     * @param[out] worklist:    terms to be marked
+     * @return:                 true if there are new terms to be marked
+     */
+    bool TermWorkshop::_MarkResults(TermSet& marked, std::vector<Term*>& worklist) {
+        for(TermWorkshop* workshop : TermWorkshop::_workshops) {
+            for(auto it = workshop->_aut->_resCache.begin(); it != workshop->_aut->_resCache.end(); ++it) {
+                if(marked.count(it->first.first)) {
+                    pushUnmarked(it->second.first, marked, worklist);
+                }
+            }
+            TermWorkshop::_MarkCacheKeys(workshop->_pCache, marked, worklist);
+            TermWorkshop::_MarkCacheKeys(workshop->_lCache, marked, worklist);
+            TermWorkshop::_MarkCacheKeys(workshop->_fpCache, marked, worklist);
+            TermWorkshop::_MarkCacheKeys(workshop->_fppCache, marked, worklist);
+            TermWorkshop::_MarkCacheKeys(workshop->_contCache, marked, worklist);
+        }
+        return !worklist.empty();
+    }
+
+    /**
+     * Removes the unmarked terms from the @p cache and collects them to the @p dead
+     */
+    template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&), Gaston::Memory::Category G>
+    void TermWorkshop::_SweepCache(BinaryCache<A, B, C, D, E, F, G>* cache, TermSet& marked, std::vector<Term*>& dead) {
+        if(cache != nullptr) {
+            cache->EraseIf([&marked, &dead](const A& key, B& data) {
+                if(marked.count(data)) {
+                    return false;
+                }
+                dead.push_back(data);
+                return true;
+            });
+        }
+    }
+
+    /**
+     * Releases the terms, that are not reachable from the @p roots, from the initial and final states and the
+     * (counter)examples of the automata, or through the result caches from other reachable terms. The caches keyed
+     * by the released terms are purged as well.
+     *
+     * May be called only, when no other terms are held outside of these structures (e.g. between the iterations
+     * of the root fixpoint).
+     *
+     * @param[in] roots:    terms held by the caller (e.g. the root fixpoint)
+     */
+    void TermWorkshop::CollectGarbage(std::vector<Term*>& roots) {
+        TermSet marked;
+        std::vector<Term*> worklist(roots);
+        for(TermWorkshop* workshop : TermWorkshop::_workshops) {
+            worklist.push_back(workshop->_aut->_initialStates);
+            worklist.push_back(workshop->_aut->_finalStates);
+            worklist.push_back(workshop->_aut->_satExample);
+            worklist.push_back(workshop->_aut->_unsatExample);
+        }
+        do {
+            TermWorkshop::_MarkReachable(worklist, marked);
+        } while(TermWorkshop::_MarkResults(marked, worklist));
+
+        // The caches are purged before the terms are released, as their keys may be compared by the contents
+        std::vector<Term*> dead;
+        for(TermWorkshop* workshop : TermWorkshop::_workshops) {
+            SymbolicAutomaton* aut = workshop->_aut;
+            aut->_resCache.EraseIf([&marked](const Gaston::ResultKey& key, Gaston::ResultType& data) {
+                return marked.count(key.first) == 0;
+            });
+            aut->_subCache.EraseIf([&marked](const Gaston::SubsumptionKey& key, SubsumptionResult& data) {
+                return marked.count(key.first) == 0 || marked.count(key.second) == 0;
+            });
+            if(workshop->_compCache != nullptr) {
+                workshop->_compCache->EraseIf([&marked](const ComputationKey& key, CacheData& data) {
+                    return marked.count(data) == 0;
+                });
+            }
+            TermWorkshop::_SweepCache(workshop->_bCache, marked, dead);
+            TermWorkshop::_SweepCache(workshop->_pCache, marked, dead);
+            TermWorkshop::_SweepCache(workshop->_lCache, marked, dead);
+            TermWorkshop::_SweepCache(workshop->_fpCache, marked, dead);
+            TermWorkshop::_SweepCache(workshop->_fppCache, marked, dead);
+            TermWorkshop::_SweepCache(workshop->_contCache, marked, dead);
+        }
+
+        // Subsumption caches of the released terms are released with them, the others forget the released keys
+        auto isReleased = [&marked](const Term_raw& key, SubsumptionResult& data) {
+            return marked.count(key) == 0;
+        };
+        for(auto& entry : Term::_isSubsumedCaches) {
+            if(marked.count(entry.first)) {
+                entry.second->EraseIf(isReleased);
+            }
+        }
+        for(auto& entry : TermFixpoint::_subsumedByCaches) {
+            if(marked.count(entry.first)) {
+                entry.second->EraseIf(isReleased);
+            }
+        }
+
+        for(Term* term : dead) {
+            delete term;
+        }
+        TermWorkshop::_liveTerms = marked.size();
+        TermWorkshop::_createdTerms = 0;
+    }
+
     /**
      * Checks if there is already created TermBaseSet in cache, in case there is not
      * it creates the new object and populates the cache.
@@ -188,7 +415,7 @@ namespace Workshops {
      * @param[in] stateno:      state number for bitmask
      * @return:                 unique pointer for TermBaseSet
      */
-    Term* TermWorkshop::CreateBaseSet(VATA::Util::OrdVector<size_t>& states, unsigned int offset, unsigned int stateno) {
+    Term* TermWorkshop::CreateBaseSet(VATA::Util::OrdVector<size_t>& states, unsigned int offset, unsigned int stateno, BaseSimulation* simulation) {
         #if (OPT_GENERATE_UNIQUE_TERMS == true && UNIQUE_BASE == true)
             assert(this->_bCache != nullptr);
 
@@ -202,13 +429,14 @@ namespace Workshops {
                 std::cout << "[*] Creating BaseSet: ";
                 #endif
                 // The object was not created yet, so we create it and store it in cache
-                termPtr = new TermBaseSet(states, offset, stateno);
+                termPtr = new TermBaseSet(states, offset, stateno, simulation);
+                ++TermWorkshop::_createdTerms;
                 this->_bCache->StoreIn(states, termPtr);
             }
             assert(termPtr != nullptr);
             return reinterpret_cast<TermBaseSet*>(termPtr);
         #else
-            return new TermBaseSet(states, offset, stateno);
+            return new TermBaseSet(states, offset, stateno, simulation);
         #endif
     }
 
@@ -236,6 +464,7 @@ namespace Workshops {
 #           endif
             // The object was not created yet, so we create it and store it in cache
             termPtr = new TermProduct(lptr, rptr, type);
+            ++TermWorkshop::_createdTerms;
             this->_pCache->StoreIn(productKey, termPtr);
         }
         assert(termPtr != nullptr);
@@ -265,6 +494,7 @@ namespace Workshops {
                 std::cout << "from ["<< startTerm << "] to ";
                 #endif
                 termPtr = new TermList(startTerm, inComplement);
+                ++TermWorkshop::_createdTerms;
                 this->_lCache->StoreIn(productKey, termPtr);
             }
             assert(termPtr != nullptr);
@@ -286,6 +516,7 @@ namespace Workshops {
                 std::cout << "from [" << source << "] to ";
                 #endif
                 termPtr = new TermFixpoint(this->_aut, source, symbol, inCompl, initValue, search);
+                ++TermWorkshop::_createdTerms;
                 this->_fpCache->StoreIn(fixpointKey, termPtr);
             }
             assert(termPtr != nullptr);
@@ -309,6 +540,7 @@ namespace Workshops {
                 std::cout << "from [" << source << "] to ";
                 #endif
                 termPtr = new TermFixpoint(this->_aut, source, symbol, inCompl);
+                ++TermWorkshop::_createdTerms;
                 this->_fppCache->StoreIn(fixpointKey, termPtr);
             }
             assert(termPtr != nullptr);
@@ -355,6 +587,7 @@ namespace Workshops {
                 std::cout << "from [" << term << "] + " << *symbol << " to ";
                 #endif
                 termPtr = new TermContinuation(aut, term, symbol, underComplement);
+                ++TermWorkshop::_createdTerms;
                 this->_contCache->StoreIn(contKey, termPtr);
             }
             assert(termPtr != nullptr);
@@ -364,6 +597,21 @@ namespace Workshops {
         #endif
     }
 
+    /**
+     * @return: bytes allocated by the caches of the workshop
+     */
+    size_t TermWorkshop::MemoryUsage() {
+        size_t bytes = 0;
+        bytes += (this->_bCache != nullptr ? this->_bCache->MemoryUsage() : 0);
+        bytes += (this->_pCache != nullptr ? this->_pCache->MemoryUsage() : 0);
+        bytes += (this->_lCache != nullptr ? this->_lCache->MemoryUsage() : 0);
+        bytes += (this->_fpCache != nullptr ? this->_fpCache->MemoryUsage() : 0);
+        bytes += (this->_fppCache != nullptr ? this->_fppCache->MemoryUsage() : 0);
+        bytes += (this->_contCache != nullptr ? this->_contCache->MemoryUsage() : 0);
+        bytes += (this->_compCache != nullptr ? this->_compCache->MemoryUsage() : 0);
+        return bytes;
+    }
+
     /***
      * Dump stats for Workshop. Dumps the cache if it is created.
      */
@@ -397,13 +645,11 @@ namespace Workshops {
     NEVER_INLINE SymbolWorkshop::SymbolWorkshop() {
         this->_symbolCache = new SymbolCache();
         this->_trimmedSymbolCache = new SymbolCache();
+        this->_remappedSymbolCache = new RemapCache();
     }
 
     NEVER_INLINE SymbolWorkshop::~SymbolWorkshop() {
-        if(_zeroSymbol != nullptr) {
-            delete SymbolWorkshop::_zeroSymbol;
-            SymbolWorkshop::_zeroSymbol = nullptr;
-        }
+        // Note: the zero symbol is shared by all of the workshops, it is released by ReleaseZeroSymbol()
         for(auto it = this->_symbolCache->begin(); it != this->_symbolCache->end(); ++it) {
             // Delete the symbol, unless it is trimmed -> it is in different structure
             if(std::get<2>(it->first) != 'T')
@@ -413,6 +659,11 @@ namespace Workshops {
         for(auto symb : this->_trimmedSymbols) {
             delete symb;
         }
+
+        for(auto it = this->_remappedSymbolCache->begin(); it != this->_remappedSymbolCache->end(); ++it) {
+            delete it->second;
+        }
+        delete this->_remappedSymbolCache;
         delete this->_trimmedSymbolCache;
         delete this->_symbolCache;
     }
@@ -426,6 +677,17 @@ namespace Workshops {
         return SymbolWorkshop::_zeroSymbol;
     }
 
+    /**
+     * Releases the shared zero symbol, so the next one is created for the current length of tracks. May be called
+     * only when no automaton that could refer it is alive.
+     */
+    void SymbolWorkshop::ReleaseZeroSymbol() {
+        if(SymbolWorkshop::_zeroSymbol != nullptr) {
+            delete SymbolWorkshop::_zeroSymbol;
+            SymbolWorkshop::_zeroSymbol = nullptr;
+        }
+    }
+
     Symbol* SymbolWorkshop::CreateTrimmedSymbol(Symbol* src, Gaston::VarList* varList) {
         // Fixme: Refactor
         // There are no symbols to trim, so we avoid the useless copy
@@ -515,9 +777,22 @@ namespace Workshops {
         }
     }
 
-    Symbol* SymbolWorkshop::CreateRemappedSymbol(Symbol* str, std::map<unsigned int, unsigned int>* map) {
-        // There should be Map of Ptr -> Ptr
-        return new Symbol(str, map);
+    /**
+     * Returns the symbol @p str with the tracks renamed by the @p map
+     *
+     * @param[in] str:      remapped symbol
+     * @param[in] map:      renaming of the tracks
+     * @param[in] mapId:    unique identifier of the @p map (addresses of the released maps may be reused)
+     * @return:             unique remapped symbol
+     */
+    Symbol* SymbolWorkshop::CreateRemappedSymbol(Symbol* str, std::map<unsigned int, unsigned int>* map, size_t mapId) {
+        auto symbolKey = std::make_pair(str, mapId);
+        Symbol* symPtr;
+        if(!this->_remappedSymbolCache->retrieveFromCache(symbolKey, symPtr)) {
+            symPtr = new Symbol(str, map);
+            this->_remappedSymbolCache->StoreIn(symbolKey, symPtr);
+        }
+        return symPtr;
     }
 
     void SymbolWorkshop::Dump() {
@@ -529,6 +804,10 @@ namespace Workshops {
         std::cout << "<[" <<  (std::get<0>(s)) << "]" << (*std::get<0>(s)) << ", " << std::get<1>(s) << ", " << std::get<2>(s) << ">";
     }
 
+    void dumpRemapKey(RemapKey const&s) {
+        std::cout << "<[" << s.first << "]" << (*s.first) << ", " << s.second << ">";
+    }
+
     void dumpSymbolData(Symbol*&s) {
         std::cout  << "<[" <<  (s) << "]" << (*s);
     }
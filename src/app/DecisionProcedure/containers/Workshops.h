@@ -32,6 +32,9 @@
  *      one global workshop, but lots of smaller workshops with lesser items. While
  *      this seems to be inefficient in terms of space, in terms of speed and
  *      cache efficiency it is to my knowledge the best approach.
+ *      Note#3: Terms live in the caches of workshops, which own them. Terms, that are
+ *      no longer reachable from the states, (counter)examples, result caches or
+ *      the given roots (live fixpoints), are released by CollectGarbage().
  *****************************************************************************/
 
 #ifndef WSKS_WORKSHOPS_H
@@ -40,7 +43,10 @@
 
 #include <boost/functional/hash.hpp>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <functional>
+#include <map>
 #include <tuple>
 #include "../environment.hh"
 #include "../../Frontend/ident.h"
@@ -54,6 +60,7 @@ class TermFixpoint;
 class TermList;
 class TermContinuation;
 class SymbolicAutomaton;
+class BaseSimulation;
 
 namespace Workshops {
     struct ComputationHash;
@@ -77,13 +84,16 @@ namespace Workshops {
     using ListKey           = Term*;
     using ListHash          = boost::hash<ListKey>;
     using ListCompare       = std::equal_to<ListKey>;
+    using RemapKey          = std::pair<Symbol*, size_t>;
+    using RemapHash         = boost::hash<RemapKey>;
+    using RemapCompare      = std::equal_to<RemapKey>;
     using FixpointKey       = std::pair<Term*, Symbol*>;
     using FixpointHash      = boost::hash<FixpointKey>;
     using FixpointCompare   = PairCompare<FixpointKey>;
     using Term_ptr          = Term*;
-    using FixpointType      = std::list<std::pair<Term*,bool>>;
+    using FixpointType      = std::list<std::pair<Term*,bool>, Gaston::Memory::Allocator<std::pair<Term*,bool>, Gaston::Memory::FixpointLists>>;
     using WorklistItemType  = std::pair<Term*, Symbol*>;
-    using WorklistType      = std::list<WorklistItemType>;
+    using WorklistType      = std::list<WorklistItemType, Gaston::Memory::Allocator<WorklistItemType, Gaston::Memory::FixpointLists>>;
     using ComputationKey    = std::pair<FixpointType*, WorklistType*>;
 
     void dumpBaseKey(BaseKey const&);
@@ -94,13 +104,15 @@ namespace Workshops {
     void dumpCacheData(CacheData &);
     void dumpSymbolKey(SymbolKey const&);
     void dumpSymbolData(Symbol* &);
+    void dumpRemapKey(RemapKey const&);
 
-    using SymbolCache       = BinaryCache<SymbolKey, Symbol*, SymbolHash, SymbolCompare, dumpSymbolKey, dumpSymbolData>;
-    using BaseCache         = BinaryCache<BaseKey, CacheData, BaseHash, BaseCompare, dumpBaseKey, dumpCacheData>;
-    using ProductCache      = BinaryCache<ProductKey, CacheData, ProductHash, ProductCompare, dumpProductKey, dumpCacheData>;
-    using ListCache         = BinaryCache<ListKey, CacheData, ListHash, ListCompare, dumpListKey, dumpCacheData>;
-    using FixpointCache     = BinaryCache<FixpointKey, CacheData, FixpointHash, FixpointCompare, dumpFixpointKey, dumpCacheData>;
-    using ComputationCache  = BinaryCache<ComputationKey, CacheData, ComputationHash, ComputationCompare, dumpComputationKey, dumpCacheData>;
+    using SymbolCache       = BinaryCache<SymbolKey, Symbol*, SymbolHash, SymbolCompare, dumpSymbolKey, dumpSymbolData, Gaston::Memory::WorkshopCaches>;
+    using RemapCache        = BinaryCache<RemapKey, Symbol*, RemapHash, RemapCompare, dumpRemapKey, dumpSymbolData, Gaston::Memory::WorkshopCaches>;
+    using BaseCache         = BinaryCache<BaseKey, CacheData, BaseHash, BaseCompare, dumpBaseKey, dumpCacheData, Gaston::Memory::WorkshopCaches>;
+    using ProductCache      = BinaryCache<ProductKey, CacheData, ProductHash, ProductCompare, dumpProductKey, dumpCacheData, Gaston::Memory::WorkshopCaches>;
+    using ListCache         = BinaryCache<ListKey, CacheData, ListHash, ListCompare, dumpListKey, dumpCacheData, Gaston::Memory::WorkshopCaches>;
+    using FixpointCache     = BinaryCache<FixpointKey, CacheData, FixpointHash, FixpointCompare, dumpFixpointKey, dumpCacheData, Gaston::Memory::WorkshopCaches>;
+    using ComputationCache  = BinaryCache<ComputationKey, CacheData, ComputationHash, ComputationCompare, dumpComputationKey, dumpCacheData, Gaston::Memory::WorkshopCaches>;
 
     class TermWorkshop {
     private:
@@ -116,11 +128,23 @@ namespace Workshops {
         static TermEmpty *_empty;
         static TermEmpty *_emptyComplement;
 
+        static std::unordered_set<TermWorkshop*> _workshops;   // Workshops of the living automata
+        static size_t _createdTerms;                            // Terms created since the last collection
+        static size_t _liveTerms;                               // Terms that survived the last collection
+
         SymbolicAutomaton* _aut;
     private:
+        using TermSet = std::unordered_set<const Term*>;
+
         // <<< PRIVATE FUNCTIONS >>>
-        template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&)>
-        inline static BinaryCache<A, B, C, D, E, F>* _cleanCache(BinaryCache<A, B, C, D, E, F>*, bool noMemberDelete = false);
+        template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&), Gaston::Memory::Category G>
+        inline static BinaryCache<A, B, C, D, E, F, G>* _cleanCache(BinaryCache<A, B, C, D, E, F, G>*, bool noMemberDelete = false);
+        template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&), Gaston::Memory::Category G>
+        static void _MarkCacheKeys(BinaryCache<A, B, C, D, E, F, G>*, TermSet&, std::vector<Term*>&);
+        template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&), Gaston::Memory::Category G>
+        static void _SweepCache(BinaryCache<A, B, C, D, E, F, G>*, TermSet&, std::vector<Term*>&);
+        static void _MarkReachable(std::vector<Term*>&, TermSet&);
+        static bool _MarkResults(TermSet&, std::vector<Term*>&);
 
     public:
         // <<< CONSTRUCTORS >>>
@@ -131,7 +155,11 @@ namespace Workshops {
         // <<< PUBLIC API >>>
         static TermEmpty* CreateEmpty();
         static TermEmpty* CreateComplementedEmpty();
-        Term* CreateBaseSet(BaseKey &states, unsigned int offset, unsigned int stateno);
+        static void ReleaseEmpty();
+        static bool ShouldCollectGarbage();
+        static void ResetGarbageCounters();
+        static void CollectGarbage(std::vector<Term*>& roots);
+        Term* CreateBaseSet(BaseKey &states, unsigned int offset, unsigned int stateno, BaseSimulation* simulation = nullptr);
         TermProduct* CreateProduct(Term_ptr const&, Term_ptr const&, ProductType);
         TermFixpoint* CreateFixpoint(Term_ptr const&, Symbol*, bool, bool, WorklistSearchType search = WorklistSearchType::E_DFS);
         TermFixpoint* CreateFixpointPre(Term_ptr const&, Symbol*, bool);
@@ -139,6 +167,7 @@ namespace Workshops {
         TermList* CreateList(Term_ptr const&, bool);
         Term* CreateContinuation(SymbolicAutomaton*, Term* const&, Symbol*, bool);
 
+        size_t MemoryUsage();
         void Dump();
     };
 
@@ -146,6 +175,7 @@ namespace Workshops {
     private:
         SymbolCache* _symbolCache = nullptr;
         SymbolCache* _trimmedSymbolCache = nullptr;
+        RemapCache* _remappedSymbolCache = nullptr;
         std::vector<Symbol*> _trimmedSymbols;
         Symbol* _CreateProjectedSymbol(Symbol*, VarType, ValType);
 
@@ -157,9 +187,10 @@ namespace Workshops {
         ~SymbolWorkshop();
 
         static Symbol* CreateZeroSymbol();
+        static void ReleaseZeroSymbol();
         Symbol* CreateSymbol(Symbol*, VarType, ValType);
         Symbol* CreateTrimmedSymbol(Symbol*, Gaston::VarList*);
-        Symbol* CreateRemappedSymbol(Symbol*, std::map<unsigned int, unsigned int>*);
+        Symbol* CreateRemappedSymbol(Symbol*, std::map<unsigned int, unsigned int>*, size_t);
 
         void Dump();
     };
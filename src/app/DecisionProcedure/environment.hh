@@ -23,13 +23,16 @@
 #include <iostream>
 #include <memory>
 #include <list>
+#include <memory>
 #include <typeinfo>
+#include <type_traits>
 #include <vata/bdd_bu_tree_aut.hh>
 #include <vata/parsing/timbuk_parser.hh>
 #include <vata/serialization/timbuk_serializer.hh>
 #include "../Frontend/dfa.h"
 #include "utils/cached_binary_op.hh"
 #include "mtbdd/ondriks_mtbdd.hh"
+#include "utils/MemoryAccounting.h"
 
 /*****************************
  * FORWARD CLASS DECLARATION *
@@ -38,7 +41,7 @@ class SymbolicAutomaton;
 class ZeroSymbol;
 class Term;
 class ASTForm;
-template<class A, class B, class C, class D, void (*E)(A const&),void (*F)(B&)>
+template<class A, class B, class C, class D, void (*E)(A const&),void (*F)(B&), Gaston::Memory::Category G = Gaston::Memory::Caches>
 class BinaryCache;
 template<class A>
 class PairCompare;
@@ -106,14 +109,14 @@ namespace Gaston {
 
 	using TermHash 				 = boost::hash<Term_raw>;
 	using TermCompare			 = std::equal_to<Term_raw>;
-	using TermCache				 = BinaryCache<Term_raw, SubsumptionResult, TermHash, TermCompare, dumpTermKey, dumpSubsumptionData>;
+	using TermCache				 = BinaryCache<Term_raw, SubsumptionResult, TermHash, TermCompare, dumpTermKey, dumpSubsumptionData, Memory::TermCaches>;
 	using ResultKey				 = std::pair<Term_raw, Symbol_ptr>;
-	using ResultCache            = BinaryCache<ResultKey, ResultType, ResultHashType, PairCompare<ResultKey>, dumpResultKey, dumpResultData>;
+	using ResultCache            = BinaryCache<ResultKey, ResultType, ResultHashType, PairCompare<ResultKey>, dumpResultKey, dumpResultData, Memory::ResultCaches>;
 	using SubsumptionKey		 = std::pair<Term_raw, Term_raw>;
-	using SubsumptionCache       = BinaryCache<SubsumptionKey, SubsumptionResult, SubsumptionHashType, PairCompare<SubsumptionKey>, dumpSubsumptionKey, dumpSubsumptionData>;
+	using SubsumptionCache       = BinaryCache<SubsumptionKey, SubsumptionResult, SubsumptionHashType, PairCompare<SubsumptionKey>, dumpSubsumptionKey, dumpSubsumptionData, Memory::ResultCaches>;
 	using DagKey				 = std::pair<Formula_ptr, bool>;
 	using DagData				 = SymbolicAutomaton*;
-	using DagNodeCache			 = BinaryCache<DagKey, DagData, DagHashType, DagCompare<DagKey>, dumpDagKey, dumpDagData>;
+	using DagNodeCache			 = BinaryCache<DagKey, DagData, DagHashType, DagCompare<DagKey>, dumpDagKey, dumpDagData, Memory::DagCaches>;
 
 	using WorkListTerm           = Term;
 	using WorkListTerm_raw       = Term*;
@@ -125,7 +128,7 @@ namespace Gaston {
 	using BaseAutomatonMTBDD	 = VATA::MTBDDPkg::OndriksMTBDD<BaseAutomatonStateSet>;
 
 	using PreKey				 = std::pair<StateType, Symbol_ptr>;
-	using PreCache				 = BinaryCache<PreKey, BaseAutomatonStateSet, PreHashType, PrePairCompare<PreKey>, dumpPreKey, dumpPreData>;
+	using PreCache				 = BinaryCache<PreKey, BaseAutomatonStateSet, PreHashType, PrePairCompare<PreKey>, dumpPreKey, dumpPreData, Memory::PreCaches>;
 }
 
 /*************************
@@ -229,6 +232,10 @@ public:
 #define MEASURE_ALL						false   // < Measure everything, not really useful
 #define MEASURE_COMPARISONS				false	// < Measure how many times we sucessfully compared and how
 #define MEASURE_SUBSUMEDBY_HITS			true	// < Measure how many times subsumedBy cache worked
+#define MEASURE_PREPROCESSING			true	// < Measure the time and size of formula for each preprocessing pass
+#define MEASURE_TRACE					true	// < Record the timeline of the decision procedure (enabled by --trace=<file>)
+#define MEASURE_PHASES					true	// < Measure time and memory of the phases (parsing, passes, construction, deciding) with --time or --profile
+#define MEASURE_MEMORY					false	// < Account bytes of terms, symbols and caches (reported at the end and on SIGUSR1)
 
 /* >>> Anti-Prenexing Options <<< *
  **********************************/
@@ -290,6 +297,31 @@ public:
 #define OPT_NO_SATURATION_FOR_M2L		true    // < Will not saturate the final states for M2L(str) logic
 #define OPT_MERGE_SUBSUMED_WORKLISTS	true    // < If the parts of the fixpoint are subsumed, but worklist aren't, merge them instead
 #define OPT_SHUFFLE_FORMULA				true	// < Will run ShuffleVisitor before creation of automaton, which should ease the procedure as well
+#define OPT_FUSE_LOCAL_REWRITES			true	// < Fuse boolean unfolding, negation pushing and quantifier merging into single traversals
+#define OPT_REORDER_TRACKS				true	// < Order the tracks (and BDD variables) by co-occurrence of variables in atoms
+#define OPT_SIMULATION_SUBSUMPTION		false	// < Compare sets of base states modulo the backward simulation of base automata
+#define OPT_SHARE_MONA_CODES			true	// < Keep one table of MONA codes (and their DFAs) for all base automata of the formula
+#define OPT_PARALLEL_MONA				false	// < Translate independent sub-DAGs of the MONA codes to DFAs in forked worker processes
+#define OPT_NARY_PRODUCTS				true	// < Flatten chains of conjunctions (disjunctions) into single n-ary product automaton
+#define OPT_COLLECT_TERMS				false	// < Release the terms unreachable from the fixpoints, results and states during the root fixpoint
+// ^- NOTE! Kept off until ctest regression-collect-terms agrees with MONA: the collection releases every term that is
+//    not reachable from the root fixpoint, the states of automata or the caches swept by TermWorkshop::CollectGarbage,
+//    hence any term held elsewhere between the iterations (e.g. by a new cache) would be left dangling.
+#define TERM_GC_MIN_TERMS				65536	// < Minimal number of terms created since the last collection to collect again
+#define PARALLEL_MONA_MIN_DEPTH			4		// < Sub-DAGs of lesser depth are translated serially (forking would cost more)
+#define PARALLEL_MONA_WORKERS			0		// < Maximal number of concurrent processes translating the DAG (0 = number of cpus)
+#define OPT_RUNTIME_SWITCHES			true	// < Switches from utils/Configuration.h can be changed at runtime, otherwise they are folded to defaults
+#define SIMULATION_MAX_TRANSITIONS		1048576	// < Simulation is not computed for base automata with more explicit transitions
+
+/* >>> Allocators <<< *
+ ***********************/
+namespace Gaston {
+namespace Memory {
+	// Allocator of the containers, their memory is charged to the category only if the memory is measured
+	template<class T, Category category>
+	using Allocator = typename std::conditional<MEASURE_MEMORY, CountingAllocator<T, category>, std::allocator<T>>::type;
+}
+}
 
 /* >>> Static Assertions <<< *
  *****************************/
@@ -26,6 +26,8 @@
 
 #include "automata.hh"
 #include "environment.hh"
+#include "utils/PhaseProfiler.h"
+#include "utils/Configuration.h"
 #include "../Frontend/timer.h"
 
 #if (OPT_SMARTER_MONA_CONVERSION == true)
@@ -723,9 +725,12 @@ void constructAutomatonByMona(ASTForm *form, Automaton& v_aut) {
 	DFA *dfa = nullptr;
 
 	timer_mona.start();
-	vars = initializeVars(form);
-	initializeOffsets(offs, vars);
-	toMonaAutomaton(form, dfa, true);
+	{
+		PROFILE_PHASE("MonaDFA");
+		vars = initializeVars(form);
+		initializeOffsets(offs, vars);
+		toMonaAutomaton(form, dfa, true);
+	}
 	timer_mona.stop();
 	#if (DUMP_INTERMEDIATE_AUTOMATA == true)
 	if(options.dump) {
@@ -733,7 +738,10 @@ void constructAutomatonByMona(ASTForm *form, Automaton& v_aut) {
 	}
     #endif
     timer_conversion.start();
-	convertMonaToVataAutomaton(v_aut, dfa, vars, numVars, offs);
+	{
+		PROFILE_PHASE("MonaToVata");
+		convertMonaToVataAutomaton(v_aut, dfa, vars, numVars, offs);
+	}
 	timer_conversion.stop();
     delete vars;
     delete[] offs;
@@ -763,7 +771,15 @@ void toMonaAutomaton(ASTForm* form, DFA*& dfa, bool minimize) {
 #   endif
 
 	// Conversion of formula representation from AST to DAG
-	codeTable = new CodeTable;
+	// Note: the shared table keeps the DAG of the previous base automata, so their common sub-DAGs are found and
+	//   their DFAs are only copied (with the renamed indices)
+	bool isShared = GASTON_OPT(shareMonaCodes);
+	if(codeTable == nullptr || !isShared) {
+		releaseMonaCodes();
+		codeTable = new CodeTable(isShared);
+		// Initialization of BDD
+		bdd_init();
+	}
 	VarCode formulaCode = form->makeCode();
 #   if (DEBUG_MONA_CODE_FORMULA == true)
 	std::cout << "[!] Transformed formula to DAG\n";
@@ -772,9 +788,6 @@ void toMonaAutomaton(ASTForm* form, DFA*& dfa, bool minimize) {
 #   endif
 
 	dfa = nullptr;
-
-	// Initialization of BDD
-	bdd_init();
 	codeTable->init_print_progress();
 
 	// Translation to DFA
@@ -797,14 +810,25 @@ void toMonaAutomaton(ASTForm* form, DFA*& dfa, bool minimize) {
     delete varnames;
     delete[] offs;
 #   endif
+	if(!isShared) {
+		releaseMonaCodes();
+	}
+}
+
+/**
+ * Releases the table of MONA codes together with the DFAs of the nodes. The nodes are bound to the identifiers and
+ * offsets of the variables, so the table has to be released whenever these are released or reassigned.
+ */
+void releaseMonaCodes() {
 	delete codeTable;
+	codeTable = nullptr;
 }
 
 IdentList* initializeVars(ASTForm *form) {
 	assert(form != nullptr);
 
 	IdentList free, bounded;
-	form->freeVars(&free, &bounded);
+	form->freeVarsCached(&free, &bounded);
 	return ident_union(&free, &bounded);
 }
 
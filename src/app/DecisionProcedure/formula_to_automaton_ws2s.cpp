@@ -10,6 +10,10 @@
 
 #include "../Frontend/ast.h"
 #include "../Frontend/symboltable.h"
+#include "../Frontend/codetable.h"
+#include "automata.hh"
+#include "containers/TreeAutomata.h"
+#include "utils/Configuration.h"
 
 #include <cstring>
 
@@ -22,6 +26,7 @@
 using std::cout;
 
 extern SymbolTable symbolTable;
+extern CodeTable *codeTable;
 
 using Automaton = VATA::BDDBottomUpTreeAut;
 
@@ -124,3 +129,76 @@ void ASTForm_Sub::toBinaryAutomaton(Automaton &subAutomaton, bool doComplement)
 void ASTForm_FirstOrder::toBinaryAutomaton(Automaton &singAutomaton, bool doComplement) {
 	cout << "Sing -> automaton\n";
 }
+
+/**
+ * Constructs the deterministic tree automaton (GTA) of the @p form by MONA, the table of MONA codes is shared with
+ * the construction of DFAs (see toMonaAutomaton)
+ *
+ * @param[in] form: formula, that is translated
+ * @param[out] gta: constructed automaton
+ * @param[in] minimize: whether the automaton should be unrestricted and minimized
+ */
+void toMonaGTA(ASTForm* form, GTA*& gta, bool minimize) {
+	assert(form != nullptr);
+
+	bool isShared = GASTON_OPT(shareMonaCodes);
+	if(codeTable == nullptr || !isShared) {
+		releaseMonaCodes();
+		codeTable = new CodeTable(isShared);
+		bdd_init();
+	}
+	VarCode formulaCode = form->makeCode();
+	codeTable->init_print_progress();
+
+	// Translation to GTA
+	gta = formulaCode.GTATranslate();
+	formulaCode.remove();
+
+	if(minimize) {
+		GTA *temp = gtaCopy(gta);
+		gtaUnrestrict(temp);
+		gta = gtaMinimize(temp);
+
+		// Clean up
+		gtaFree(temp);
+	}
+
+	if(!isShared) {
+		releaseMonaCodes();
+	}
+}
+
+/**
+ * Constructs the symbolic tree automaton of the @p form. Boolean connectives and second-order quantifiers of the
+ * tagged formulae are constructed lazily, the rest is constructed by MONA.
+ *
+ * @param[in] form: formula, that is translated
+ * @return: symbolic tree automaton of the @p form
+ */
+TreeAutomaton* toTreeAutomaton(ASTForm* form) {
+	assert(form != nullptr);
+
+	if(form->tag != 0) {
+		switch(form->kind) {
+			case aAnd:
+			case aOr: {
+				ASTForm_ff* binary = static_cast<ASTForm_ff*>(form);
+				return new BinaryOpTreeAutomaton(toTreeAutomaton(binary->f1), toTreeAutomaton(binary->f2),
+												 (form->kind == aAnd) ? AutType::INTERSECTION : AutType::UNION);
+			}
+			case aNot:
+				return new ComplementTreeAutomaton(toTreeAutomaton(static_cast<ASTForm_Not*>(form)->f));
+			case aEx2: {
+				ASTForm_Ex2* ex = static_cast<ASTForm_Ex2*>(form);
+				return new ProjectionTreeAutomaton(toTreeAutomaton(ex->f), ex->vl);
+			}
+			default:
+				break;
+		}
+	}
+
+	GTA *gta = nullptr;
+	toMonaGTA(form, gta, true);
+	assert(gta != nullptr);
+	return new BaseTreeAutomaton(gta, form);
+}
@@ -9,6 +9,7 @@
 #include "../DecisionProcedure/environment.hh"
 #include "../DecisionProcedure/automata.hh"
 #include "../DecisionProcedure/visitors/NegationUnfolder.h"
+#include "../DecisionProcedure/utils/Configuration.h"
 #include <memory>
 
 extern Timer timer_base;
@@ -23,7 +24,7 @@ SymbolicAutomaton* baseToSymbolicAutomaton(ASTForm* form, bool doComplement) {
     int numVars = varMap.TrackLength();
 
     IdentList free, bound;
-    form->freeVars(&free, &bound);
+    form->freeVarsCached(&free, &bound);
 
     toMonaAutomaton(form, dfa, true);
     assert(dfa != nullptr);
@@ -41,23 +42,20 @@ SymbolicAutomaton* ASTForm::toSymbolicAutomaton(bool doComplement) {
     // we return the pointer, otherwise we first create the symbolic
     // automaton and return the thing.
     if(this->sfa == nullptr) {
-#       if (OPT_USE_DAG == true)
-        bool isComplemented;
         auto key = std::make_pair(this, doComplement);
         // First look into the dag, if there is already something structurally similar
-        if(!SymbolicAutomaton::dagNodeCache->retrieveFromCache(key, this->sfa)) {
+        if(!GASTON_OPT(useDag) || !SymbolicAutomaton::dagNodeCache->retrieveFromCache(key, this->sfa)) {
             // If yes, return the automaton (the mapping will be constructed internally)
-#       endif
             if (this->tag == 0) {
                 // It was tagged to be constructed by MONA
                 this->sfa = baseToSymbolicAutomaton<GenericBaseAutomaton>(this, doComplement);
             } else {
                 this->sfa = this->_toSymbolicAutomatonCore(doComplement);
             }
-#       if (OPT_USE_DAG == true)
-            SymbolicAutomaton::dagNodeCache->StoreIn(key, this->sfa);
+            if(GASTON_OPT(useDag)) {
+                SymbolicAutomaton::dagNodeCache->StoreIn(key, this->sfa);
+            }
         }
-#       endif
     }
     return this->sfa;
 }
@@ -107,12 +105,48 @@ SymbolicAutomaton* ASTForm_Sub::_toSymbolicAutomatonCore(bool doComplement) {
     return baseToSymbolicAutomaton<SubAutomaton>(this, doComplement);
 }
 
+/**
+ * Collects the operands of the chain of binary formulae of the @p kind (i.e. conjunctions or disjunctions) rooted in
+ * @p form. The subformulae, that are already converted or are to be converted by MONA, end the chain. The inner
+ * nodes of the chain get no automata (nor entries in the DAG), so only the whole chain and its operands are shared.
+ *
+ * @param[in] form:             formula in the chain
+ * @param[in] kind:             kind of the chain
+ * @param[in] doComplement:     true if we are making complementon
+ * @param[out] operands:        automata of the operands with their formulae
+ */
+void collectProductOperands(ASTForm* form, ASTKind kind, bool doComplement, std::vector<std::pair<SymbolicAutomaton*, ASTForm*>>& operands) {
+    bool isInChain = (form->kind == kind && form->tag != 0 && form->sfa == nullptr);
+    if(isInChain && GASTON_OPT(useDag)) {
+        // Automata shared by the DAG are kept as operands
+        SymbolicAutomaton* shared;
+        auto key = std::make_pair(form, doComplement);
+        isInChain = !SymbolicAutomaton::dagNodeCache->retrieveFromCache(key, shared);
+    }
+    if(isInChain) {
+        ASTForm_ff* binaryForm = static_cast<ASTForm_ff*>(form);
+        collectProductOperands(binaryForm->f1, kind, doComplement, operands);
+        collectProductOperands(binaryForm->f2, kind, doComplement, operands);
+    } else {
+        operands.push_back(std::make_pair(form->toSymbolicAutomaton(doComplement), form));
+    }
+}
+
 /**
  * Returns IntersectionAutomaton consisting of converted left and right automaton
  *
  * @param doComplement: true if we are making complementon
  */
 SymbolicAutomaton* ASTForm_And::_toSymbolicAutomatonCore(bool doComplement) {
+    if(GASTON_OPT(naryProducts)) {
+        std::vector<std::pair<SymbolicAutomaton*, ASTForm*>> operands;
+        collectProductOperands(this->f1, aAnd, doComplement, operands);
+        collectProductOperands(this->f2, aAnd, doComplement, operands);
+        if(operands.size() > 2) {
+            return new NaryIntersectionAutomaton(operands, this);
+        }
+        return new IntersectionAutomaton(operands[0].first, operands[1].first, this);
+    }
     SymbolicAutomaton* lhs_aut;
     lhs_aut = this->f1->toSymbolicAutomaton(doComplement);
     SymbolicAutomaton* rhs_aut;
@@ -121,6 +155,15 @@ SymbolicAutomaton* ASTForm_And::_toSymbolicAutomatonCore(bool doComplement) {
 }
 
 SymbolicAutomaton* ASTForm_Or::_toSymbolicAutomatonCore(bool doComplement) {
+    if(GASTON_OPT(naryProducts)) {
+        std::vector<std::pair<SymbolicAutomaton*, ASTForm*>> operands;
+        collectProductOperands(this->f1, aOr, doComplement, operands);
+        collectProductOperands(this->f2, aOr, doComplement, operands);
+        if(operands.size() > 2) {
+            return new NaryUnionAutomaton(operands, this);
+        }
+        return new UnionAutomaton(operands[0].first, operands[1].first, this);
+    }
     SymbolicAutomaton* lhs_aut;
     lhs_aut = this->f1->toSymbolicAutomaton(doComplement);
     SymbolicAutomaton* rhs_aut;
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: gtawrapper.hh
+ *  Description:
+ *      Wrapper of the deterministic bottom-up tree automaton (GTA) of MONA,
+ *      that computes the successors of the pairs of states over concrete
+ *      symbols by walking the BDDs of the behaviour.
+ *****************************************************************************/
+
+#ifndef GTAWRAPPER_H
+#define GTAWRAPPER_H
+
+#include <cassert>
+#include <string>
+#include "../../Frontend/st_gta.h"
+#include "../containers/VarToTrackMap.hh"
+
+extern VarToTrackMap varMap;
+
+class GtaWrapper {
+public:
+    // <<< PUBLIC CONSTRUCTORS AND DESTRUCTORS >>>
+    explicit GtaWrapper(GTA* gta) : _gta(gta) { assert(gta != nullptr); }
+    ~GtaWrapper() { gtaFree(this->_gta); }
+
+    GtaWrapper(const GtaWrapper&) = delete;
+    GtaWrapper& operator=(const GtaWrapper&) = delete;
+
+    // <<< PUBLIC API >>>
+    State GetInitialState(SsId d) const { return this->_gta->ss[d].initial; }
+    unsigned int GetStateNo(SsId d) const { return this->_gta->ss[d].size; }
+    bool IsFinal(State q) const { return this->_gta->final[q] == 1; }
+
+    /**
+     * Returns the state reached in the state space @p d from the states @p left and @p right of the children (in the
+     * left and right successor state spaces of the guide) over the @p symbol
+     *
+     * @param[in] d:        state space of the node
+     * @param[in] left:     state of the left child
+     * @param[in] right:    state of the right child
+     * @param[in] symbol:   values ('0'/'1') of the tracks
+     * @return:             successor state
+     */
+    State Post(SsId d, State left, State right, const std::string& symbol) const {
+        const StateSpace& ss = this->_gta->ss[d];
+        bdd_manager* bddm = ss.bddm;
+        unsigned int node = BDD_ROOT(bddm, BEH(ss, left, right));
+        unsigned int l, r, index;
+        LOAD_lri(&bddm->node_table[node], l, r, index);
+        while(index != BDD_LEAF_INDEX) {
+            node = (symbol[varMap.TrackOfIndex(index)] == '1') ? r : l;
+            LOAD_lri(&bddm->node_table[node], l, r, index);
+        }
+        return l;
+    }
+
+private:
+    // <<< PRIVATE MEMBERS >>>
+    GTA* _gta;
+};
+
+#endif //GTAWRAPPER_H
@@ -4,11 +4,13 @@
 #include "../../Frontend/ast.h"
 
 #include <vata/util/ord_vector.hh>
+#include <vata/explicit_lts.hh>
 
 #include "ondriks_mtbdd.hh"
 #include "../containers/VarToTrackMap.hh"
 
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -77,7 +79,7 @@ private:
         leafNodes_[state] = new WrappedNode(state, 0xfffffffe);
         LOAD_index(&bddm->node_table[addr], index);
 
-        if(index != BDD_LEAF_INDEX && varMap[index] == 0)
+        if(index != BDD_LEAF_INDEX && varMap.TrackOfIndex(index) == 0)
             return leafNodes_[state];
 
         WrappedNode *result = spawnNode(addr, *leafNodes_[state], 1);
@@ -100,7 +102,7 @@ private:
         }
         else
         {
-            node.var_ = SetVar(varMap[index]);
+            node.var_ = SetVar(varMap.TrackOfIndex(index));
             RecSetPointer(bddm, l, *spawnNode(l, node, 0));
             RecSetPointer(bddm, r, *spawnNode(r, node, 1));
         }
@@ -317,10 +319,10 @@ public:
         }
         else
         {
-            transition[varMap[index]] = '0';
+            transition[varMap.TrackOfIndex(index)] = '0';
             GetAllPathFromMona(bddm, l, transition, root, varNum);
 
-            transition[varMap[index]] = '1';
+            transition[varMap.TrackOfIndex(index)] = '1';
             GetAllPathFromMona(bddm, r, transition, root, varNum);
         }
     }
@@ -362,6 +364,77 @@ public:
     size_t GetInitialState() {
         return this->initialState_;
     }
+
+    size_t GetStateNo() {
+        return this->dfa_->ns;
+    }
+
+    /**
+     * Builds the LTS with reversed transitions of the wrapped automaton. The letters of LTS are the explicit
+     * assignments to the BDD variables used by the automaton, so the LTS is built only if there are at most
+     * @p maxTransitions of transitions.
+     *
+     * @param[out] lts: LTS with reversed transitions
+     * @param[in] maxTransitions: limit on the number of explicit transitions
+     * @return: true if the LTS was built
+     */
+    bool BuildReversedLTS(VATA::ExplicitLTS& lts, size_t maxTransitions)
+    {
+        std::vector<unsigned> indices;
+        std::unordered_set<unsigned> visited;
+        for(size_t i = this->initialState_; i < this->dfa_->ns; ++i)
+            CollectIndices(this->dfa_->bddm, this->dfa_->q[i], indices, visited);
+        std::sort(indices.begin(), indices.end());
+
+        size_t states = this->dfa_->ns - this->initialState_;
+        if(indices.size() >= 8*sizeof(size_t) || (states << indices.size()) > maxTransitions || (states << indices.size()) >> indices.size() != states)
+            return false;
+
+        for(size_t i = this->initialState_; i < this->dfa_->ns; ++i)
+            RecAddReversed(lts, this->dfa_->bddm, this->dfa_->q[i], indices, 0, 0, i);
+        return true;
+    }
+
+private:
+    void CollectIndices(const bdd_manager *bddm, unsigned p, std::vector<unsigned>& indices, std::unordered_set<unsigned>& visited)
+    {
+        unsigned l, r, index;
+
+        if(!visited.insert(p).second)
+            return;
+
+        LOAD_lri(&bddm->node_table[p], l, r, index);
+        if (index != BDD_LEAF_INDEX)
+        {
+            if(std::find(indices.begin(), indices.end(), index) == indices.end())
+                indices.push_back(index);
+            CollectIndices(bddm, l, indices, visited);
+            CollectIndices(bddm, r, indices, visited);
+        }
+    }
+
+    void RecAddReversed(VATA::ExplicitLTS& lts, const bdd_manager *bddm, unsigned p, const std::vector<unsigned>& indices, size_t pos, size_t letter, size_t source)
+    {
+        unsigned l, r, index;
+
+        LOAD_lri(&bddm->node_table[p], l, r, index);
+        if(pos == indices.size())
+        {
+            assert(index == BDD_LEAF_INDEX);
+            lts.addTransition(l, letter, source);
+        }
+        else if(index != indices[pos])
+        {
+            // don't care on the variable
+            RecAddReversed(lts, bddm, p, indices, pos + 1, letter, source);
+            RecAddReversed(lts, bddm, p, indices, pos + 1, letter | (static_cast<size_t>(1) << pos), source);
+        }
+        else
+        {
+            RecAddReversed(lts, bddm, l, indices, pos + 1, letter, source);
+            RecAddReversed(lts, bddm, r, indices, pos + 1, letter | (static_cast<size_t>(1) << pos), source);
+        }
+    }
 };
 
 
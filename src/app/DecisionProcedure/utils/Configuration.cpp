@@ -0,0 +1,137 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: Configuration.cpp
+ *  Description:
+ *      Optimizations of the decision procedure, that can be switched at
+ *      runtime by command line or configuration file. The defaults are
+ *      taken from environment.hh. If OPT_RUNTIME_SWITCHES is disabled,
+ *      the switches are folded to their defaults during the compilation.
+ *****************************************************************************/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "Configuration.h"
+
+namespace Gaston {
+    Configuration config;
+
+    namespace {
+        /**
+         * Strips the leading and trailing whitespaces of @p str
+         */
+        std::string trim(const std::string& str) {
+            size_t first = str.find_first_not_of(" \t\r");
+            if(first == std::string::npos) {
+                return "";
+            }
+            size_t last = str.find_last_not_of(" \t\r");
+            return str.substr(first, last - first + 1);
+        }
+    }
+
+    /**
+     * Sets the optimization switch @p name to @p value
+     *
+     * @param[in] name:     name of the switch (e.g. prune-empty)
+     * @param[in] value:    new value of the switch
+     * @return:             false if there is no such switch
+     */
+    bool Configuration::Set(const char* name, bool value) {
+        if(value && strcmp(name, "use-dag") == 0 && (OPT_SYMBOL_HASH_BY_APPROX == true || OPT_EARLY_EVALUATION == true)) {
+            // Symbols hashed by pointers and continuations cannot be shared by the DAG
+            std::cerr << "[!] Switch 'use-dag' conflicts with OPT_SYMBOL_HASH_BY_APPROX or OPT_EARLY_EVALUATION\n";
+            return false;
+        }
+#       define SET_SWITCH(member, switchName, defaultValue, description) \
+            if(strcmp(name, switchName) == 0) { this->member = value; return true; }
+        CONFIGURATION_SWITCHES(SET_SWITCH)
+#       undef SET_SWITCH
+        return false;
+    }
+
+    /**
+     * Parses the assignment of form "name = value", where value is one of on/off, true/false or 1/0
+     *
+     * @param[in] assignment:   assignment of the switch
+     * @return:                 false if the assignment is malformed or there is no such switch
+     */
+    bool Configuration::ParseSwitch(const char* assignment) {
+        std::string line(assignment);
+        size_t eq = line.find('=');
+        if(eq == std::string::npos) {
+            return false;
+        }
+
+        std::string name = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+        if(value == "on" || value == "true" || value == "1") {
+            return this->Set(name.c_str(), true);
+        } else if(value == "off" || value == "false" || value == "0") {
+            return this->Set(name.c_str(), false);
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * Loads the switches from configuration file @p path. Each line contains one assignment
+     * "name = value", empty lines and lines starting with '#' are skipped.
+     *
+     * @param[in] path:     path to the configuration file
+     * @return:             false if the file cannot be read or contains malformed line
+     */
+    bool Configuration::LoadFromFile(const char* path) {
+        std::ifstream file(path);
+        if(!file.is_open()) {
+            std::cerr << "[!] Cannot open configuration file '" << path << "'\n";
+            return false;
+        }
+
+        std::string line;
+        size_t lineNo = 0;
+        while(std::getline(file, line)) {
+            ++lineNo;
+            line = trim(line);
+            if(line.empty() || line[0] == '#') {
+                continue;
+            }
+            if(!this->ParseSwitch(line.c_str())) {
+                std::cerr << "[!] " << path << ":" << lineNo << ": invalid switch '" << line << "'\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Prints the current values of the switches
+     */
+    void Configuration::Dump() {
+#       if (OPT_RUNTIME_SWITCHES == false)
+        std::cout << "[*] Runtime switches are disabled, using the defaults:\n";
+#       endif
+#       define DUMP_SWITCH(member, switchName, defaultValue, description) \
+            std::cout << "\t\u2218 " << switchName << ": " << (GASTON_OPT(member) ? "on" : "off") << "\n";
+        CONFIGURATION_SWITCHES(DUMP_SWITCH)
+#       undef DUMP_SWITCH
+    }
+
+    /**
+     * Prints the list of available switches with their defaults for usage
+     */
+    void Configuration::PrintSwitches() {
+#       define PRINT_SWITCH(member, switchName, defaultValue, description) \
+            std::cout << "  " << switchName << " [" << (defaultValue ? "on" : "off") << "]: " << description << "\n";
+        CONFIGURATION_SWITCHES(PRINT_SWITCH)
+#       undef PRINT_SWITCH
+    }
+}
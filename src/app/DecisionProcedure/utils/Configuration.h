@@ -0,0 +1,73 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: Configuration.h
+ *  Description:
+ *      Optimizations of the decision procedure, that can be switched at
+ *      runtime by command line or configuration file. The defaults are
+ *      taken from environment.hh. If OPT_RUNTIME_SWITCHES is disabled,
+ *      the switches are folded to their defaults during the compilation.
+ *****************************************************************************/
+
+#ifndef WSKS_CONFIGURATION_H
+#define WSKS_CONFIGURATION_H
+
+#include "../environment.hh"
+
+// <<< MACROS >>>
+
+// code(member, name, default, description)
+#define CONFIGURATION_SWITCHES(code) \
+    code(pruneEmpty,            "prune-empty",              OPT_PRUNE_EMPTY,            "Prune terms by empty set") \
+    code(earlyPartialSub,       "early-partial-sub",        OPT_EARLY_PARTIAL_SUB,      "Postpone the partially subsumed terms") \
+    code(reducePrefixpoint,     "reduce-prefixpoint",       OPT_REDUCE_PREFIXPOINT,     "Prune the fixpoint when returning pre") \
+    code(reduceFullFixpoint,    "reduce-full-fixpoint",     OPT_REDUCE_FULL_FIXPOINT,   "Prune the fixpoint by subsumption") \
+    code(cacheSubsumes,         "cache-subsumes",           OPT_CACHE_SUBSUMES,         "Cache the results of subsumption testing between terms") \
+    code(fixpointBfsSearch,     "fixpoint-bfs-search",      OPT_FIXPOINT_BFS_SEARCH,    "Add new things to the back of the worklist in fixpoint") \
+    code(shuffleFormula,        "shuffle-formula",          OPT_SHUFFLE_FORMULA,        "Run ShuffleVisitor before creation of automaton") \
+    code(reorderTracks,         "reorder-tracks",           OPT_REORDER_TRACKS,         "Order the tracks by co-occurrence of variables in atoms") \
+    code(simulationSubsumption, "simulation-subsumption",   OPT_SIMULATION_SUBSUMPTION, "Compare sets of base states modulo simulation") \
+    code(shareMonaCodes,        "share-mona-codes",         OPT_SHARE_MONA_CODES,       "Keep one MONA code table (and DFAs) for all base automata") \
+    code(parallelMona,          "parallel-mona",            OPT_PARALLEL_MONA,          "Translate independent sub-DAGs of MONA codes in worker processes") \
+    code(naryProducts,          "nary-products",            OPT_NARY_PRODUCTS,          "Flatten chains of conjunctions (disjunctions) into n-ary products") \
+    code(collectTerms,          "collect-terms",            OPT_COLLECT_TERMS,          "Release unreachable terms during the root fixpoint") \
+    code(useDag,                "use-dag",                  OPT_USE_DAG,                "Share the automata of structurally equal subformulae")
+
+#define DECLARE_SWITCH(member, name, value, description) bool member = value;
+#define DECLARE_DEFAULT(member, name, value, description) static constexpr bool member = value;
+
+#if (OPT_RUNTIME_SWITCHES == true)
+#   define GASTON_OPT(member) (Gaston::config.member)
+#else
+#   define GASTON_OPT(member) (Gaston::Configuration::Defaults::member)
+#endif
+
+namespace Gaston {
+    class Configuration {
+    public:
+        // <<< PUBLIC MEMBERS >>>
+        struct Defaults {
+            CONFIGURATION_SWITCHES(DECLARE_DEFAULT)
+        };
+        CONFIGURATION_SWITCHES(DECLARE_SWITCH)
+
+        // <<< PUBLIC API >>>
+        bool Set(const char* name, bool value);
+        bool ParseSwitch(const char* assignment);
+        bool LoadFromFile(const char* path);
+        void Dump();
+        static void PrintSwitches();
+    };
+
+    extern Configuration config;
+}
+
+#undef DECLARE_SWITCH
+#undef DECLARE_DEFAULT
+#endif //WSKS_CONFIGURATION_H
@@ -0,0 +1,128 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: MemoryAccounting.cpp
+ *  Description:
+ *      Byte-level accounting of memory of terms, symbols, fixpoint lists
+ *      and caches. Containers use the counting allocator, which charges
+ *      the allocated bytes to the category and optionally to the counter
+ *      of its owner (e.g. cache of the automaton node). The report can be
+ *      printed at the end of the run or on SIGUSR1.
+ *****************************************************************************/
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <signal.h>
+#include <unistd.h>
+#include "MemoryAccounting.h"
+
+namespace Gaston {
+namespace Memory {
+    Counter counters[CategoryCount];
+
+    namespace {
+#       define CATEGORY_NAME(category) #category,
+        const char* categoryNames[] = { MEMORY_CATEGORIES(CATEGORY_NAME) };
+#       undef CATEGORY_NAME
+
+        /**
+         * Appends @p str to @p buffer, only async-signal-safe functions are used
+         */
+        size_t append(char* buffer, size_t pos, size_t size, const char* str) {
+            while(*str != '\0' && pos < size) {
+                buffer[pos++] = *str++;
+            }
+            return pos;
+        }
+
+        /**
+         * Appends decimal representation of @p number to @p buffer, only async-signal-safe functions are used
+         */
+        size_t append(char* buffer, size_t pos, size_t size, size_t number) {
+            char digits[24];
+            size_t len = 0;
+            do {
+                digits[len++] = '0' + (number % 10);
+                number /= 10;
+            } while(number != 0);
+            while(len != 0 && pos < size) {
+                buffer[pos++] = digits[--len];
+            }
+            return pos;
+        }
+
+        /**
+         * Writes the report to stderr on SIGUSR1. Since the handler interrupts the computation, it cannot allocate
+         * or use streams, so the report is formatted by hand and written by write(2).
+         */
+        void reportHandler(int) {
+            char buffer[4096];
+            size_t pos = 0, size = sizeof(buffer);
+            size_t total = 0;
+            pos = append(buffer, pos, size, "[*] Memory (live kB / peak kB / allocations):\n");
+            for(size_t i = 0; i < CategoryCount; ++i) {
+                total += counters[i].live;
+                pos = append(buffer, pos, size, "\t");
+                pos = append(buffer, pos, size, categoryNames[i]);
+                pos = append(buffer, pos, size, ": ");
+                pos = append(buffer, pos, size, counters[i].live / 1024);
+                pos = append(buffer, pos, size, " / ");
+                pos = append(buffer, pos, size, counters[i].peak / 1024);
+                pos = append(buffer, pos, size, " / ");
+                pos = append(buffer, pos, size, counters[i].allocations);
+                pos = append(buffer, pos, size, "\n");
+            }
+            pos = append(buffer, pos, size, "[*] Memory total: ");
+            pos = append(buffer, pos, size, total / 1024);
+            pos = append(buffer, pos, size, " kB\n");
+
+            size_t written = 0;
+            while(written < pos) {
+                ssize_t res = write(STDERR_FILENO, buffer + written, pos - written);
+                if(res <= 0) {
+                    break;
+                }
+                written += res;
+            }
+        }
+    }
+
+    /**
+     * Prints the live bytes, the peak and number of allocations for each category
+     */
+    void Dump() {
+        size_t total = 0;
+        std::cout << "[*] Memory:\n";
+        for(size_t i = 0; i < CategoryCount; ++i) {
+            if(counters[i].allocations == 0) {
+                continue;
+            }
+            total += counters[i].live;
+            std::cout << "\t\u2218 " << std::left << std::setw(20) << categoryNames[i] << std::right;
+            std::cout << std::fixed << std::setprecision(2) << std::setw(12) << (counters[i].live / 1024.0) << "kB";
+            std::cout << ", peak: " << (counters[i].peak / 1024.0) << "kB";
+            std::cout << ", allocations: " << counters[i].allocations << "\n";
+        }
+        std::cout << "[*] Memory total: " << std::fixed << std::setprecision(2) << (total / 1024.0) << "kB\n";
+    }
+
+    /**
+     * Installs the handler of SIGUSR1, that prints the report while running
+     */
+    void InstallReportHandler() {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = reportHandler;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGUSR1, &action, nullptr);
+    }
+}
+}
@@ -0,0 +1,146 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: MemoryAccounting.h
+ *  Description:
+ *      Byte-level accounting of memory of terms, symbols, fixpoint lists
+ *      and caches. Containers use the counting allocator, which charges
+ *      the allocated bytes to the category and optionally to the counter
+ *      of its owner (e.g. cache of the automaton node). The report can be
+ *      printed at the end of the run or on SIGUSR1. Unless MEASURE_MEMORY
+ *      is set, the containers use std::allocator (see environment.hh).
+ *****************************************************************************/
+
+#ifndef WSKS_MEMORYACCOUNTING_H
+#define WSKS_MEMORYACCOUNTING_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// <<< MACROS >>>
+#define MEMORY_CATEGORIES(code) \
+    code(TermEmpty)             \
+    code(TermProduct)           \
+    code(TermBaseSet)           \
+    code(TermList)              \
+    code(TermFixpoint)          \
+    code(TermContinuation)      \
+    code(FixpointLists)         \
+    code(SymbolLists)           \
+    code(TermCaches)            \
+    code(Symbols)               \
+    code(WorkshopCaches)        \
+    code(ResultCaches)          \
+    code(PreCaches)             \
+    code(DagCaches)             \
+    code(Caches)
+
+#define DEFINE_CATEGORY(category) category,
+
+namespace Gaston {
+namespace Memory {
+    enum Category {
+        MEMORY_CATEGORIES(DEFINE_CATEGORY)
+        CategoryCount
+    };
+
+    struct Counter {
+        size_t live = 0;            // << Currently allocated bytes
+        size_t peak = 0;            // << Peak of allocated bytes
+        size_t allocations = 0;     // << Number of allocations
+
+        void Allocate(size_t bytes) {
+            this->live += bytes;
+            ++this->allocations;
+            if(this->live > this->peak) {
+                this->peak = this->live;
+            }
+        }
+
+        void Free(size_t bytes) {
+            this->live -= bytes;
+        }
+    };
+
+    extern Counter counters[CategoryCount];
+
+    inline void Allocate(Category category, size_t bytes) {
+        counters[category].Allocate(bytes);
+    }
+
+    inline void Free(Category category, size_t bytes) {
+        counters[category].Free(bytes);
+    }
+
+    void Dump();
+    void InstallReportHandler();
+
+    /**
+     * Allocator, that charges the allocated bytes to the @p category and to the counter of the owner (if set)
+     */
+    template<class T, Category category>
+    class CountingAllocator {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template<class U>
+        struct rebind {
+            typedef CountingAllocator<U, category> other;
+        };
+
+        Counter* owner;
+
+        CountingAllocator() : owner(nullptr) {}
+        explicit CountingAllocator(Counter* o) : owner(o) {}
+        template<class U>
+        CountingAllocator(const CountingAllocator<U, category>& other) : owner(other.owner) {}
+
+        T* allocate(size_t n, const void* = nullptr) {
+            size_t bytes = n*sizeof(T);
+            Allocate(category, bytes);
+            if(this->owner != nullptr) {
+                this->owner->Allocate(bytes);
+            }
+            return static_cast<T*>(::operator new(bytes));
+        }
+
+        void deallocate(T* p, size_t n) {
+            size_t bytes = n*sizeof(T);
+            Free(category, bytes);
+            if(this->owner != nullptr) {
+                this->owner->Free(bytes);
+            }
+            ::operator delete(p);
+        }
+
+        size_t max_size() const { return static_cast<size_t>(-1) / sizeof(T); }
+
+        template<class U, class... Args>
+        void construct(U* p, Args&&... args) { ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+
+        template<class U>
+        void destroy(U* p) { p->~U(); }
+
+        template<class U>
+        bool operator==(const CountingAllocator<U, category>& other) const { return this->owner == other.owner; }
+        template<class U>
+        bool operator!=(const CountingAllocator<U, category>& other) const { return this->owner != other.owner; }
+    };
+}
+}
+
+#undef DEFINE_CATEGORY
+#endif //WSKS_MEMORYACCOUNTING_H
@@ -0,0 +1,174 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: ParallelTranslation.cpp
+ *  Description:
+ *      Concurrent translation of the MONA code DAG to DFA.
+ *****************************************************************************/
+
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ParallelTranslation.h"
+#include "Configuration.h"
+#include "../environment.hh"
+#include "../../Frontend/env.h"
+
+extern Options options;
+
+namespace Gaston {
+    namespace {
+        // Number of processes, that can run concurrently, including this one (initialized on first use)
+        int budget = 0;
+
+        /**
+         * @param[in] vc:   node of the DAG
+         * @return:         true if the sub-DAG is worth of translating in the worker
+         */
+        bool IsWorthForking(VarCode& vc) {
+            return vc.code->dfa == nullptr && !vc.code->mark && vc.code->depth >= PARALLEL_MONA_MIN_DEPTH;
+        }
+
+        /**
+         * Collects the nodes of the sub-DAG @p code, that are not translated yet
+         *
+         * @param[in] code:     root of the sub-DAG
+         * @param[out] nodes:   nodes of the sub-DAG
+         */
+        void CollectNodes(Code* code, std::unordered_set<Code*>& nodes) {
+            if(code->dfa != nullptr || !nodes.insert(code).second) {
+                return;
+            }
+            if(Code_c* unary = dynamic_cast<Code_c*>(code)) {
+                CollectNodes(unary->vc.code, nodes);
+            } else if(Code_cc* binary = dynamic_cast<Code_cc*>(code)) {
+                CollectNodes(binary->vc1.code, nodes);
+                CollectNodes(binary->vc2.code, nodes);
+            }
+        }
+
+        /**
+         * @param[in] first:    sub-DAG
+         * @param[in] second:   sub-DAG
+         * @return:             true if the sub-DAGs have some untranslated node in common, which would be then
+         *                      translated by both of the processes
+         */
+        bool AreSharing(VarCode& first, VarCode& second) {
+            std::unordered_set<Code*> firstNodes, secondNodes;
+            CollectNodes(first.code, firstNodes);
+            CollectNodes(second.code, secondNodes);
+            for(Code* node : secondNodes) {
+                if(firstNodes.find(node) != firstNodes.end()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Translates the sub-DAG @p vc in the worker process and exports the DFA to the @p path. The worker never
+         * returns, in particular it does not flush the buffers nor run the destructors inherited from the parent.
+         *
+         * @param[in] vc:       translated sub-DAG
+         * @param[in] path:     file for the DFA
+         */
+        void RunWorker(VarCode& vc, char* path) {
+            int status = EXIT_FAILURE;
+            try {
+                // Translated in the variables of the node itself, the parent renames them as with the cached DFA
+                VarCode node(&vc.code->vars, vc.code);
+                DFA* dfa = node.DFATranslate();
+                if(dfaExport(dfa, path, 0, nullptr, nullptr)) {
+                    status = EXIT_SUCCESS;
+                }
+            } catch (...) {
+                // MONA failures are reported by the parent, that translates the sub-DAG on its own
+            }
+            _exit(status);
+        }
+    }
+
+    /**
+     * Translates the sub-DAGs @p first and @p second of the binary node, the @p second one in the forked worker.
+     * The DFA of the worker is stored to the node as if it was translated by the parent, so the copying and
+     * renaming of the variables is left to VarCode::DFATranslate. If the worker fails, the parent translates the
+     * @p second on its own. Nothing is forked in the library mode or if the sub-DAGs share some nodes.
+     *
+     * @param[in] first:        sub-DAG translated by the parent
+     * @param[out] firstDfa:    DFA of the @p first
+     * @param[in] second:       sub-DAG translated by the worker
+     * @param[out] secondDfa:   DFA of the @p second
+     * @return:                 false if the translation was not done (and should be done serially)
+     */
+    bool TranslateConcurrently(VarCode& first, DFA*& firstDfa, VarCode& second, DFA*& secondDfa) {
+        if(!GASTON_OPT(parallelMona) || options.libraryMode || !IsWorthForking(first) || !IsWorthForking(second)) {
+            return false;
+        }
+        if(budget == 0) {
+            budget = (PARALLEL_MONA_WORKERS > 0) ? PARALLEL_MONA_WORKERS : static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+        }
+        if(budget < 2 || AreSharing(first, second)) {
+            return false;
+        }
+
+        const char* tmpDir = getenv("TMPDIR");
+        std::string tmpPath = std::string(tmpDir != nullptr && *tmpDir != '\0' ? tmpDir : "/tmp") + "/gaston-dfa-XXXXXX";
+        std::vector<char> pathBuffer(tmpPath.begin(), tmpPath.end());
+        pathBuffer.push_back('\0');
+        char* path = pathBuffer.data();
+        int fd = mkstemp(path);
+        if(fd == -1) {
+            return false;
+        }
+        close(fd);
+
+        int parentBudget = budget;
+        int workerBudget = budget / 2;
+        pid_t worker = fork();
+        if(worker == -1) {
+            unlink(path);
+            return false;
+        } else if(worker == 0) {
+            budget = workerBudget;
+            RunWorker(second, path);
+        }
+
+        budget = parentBudget - workerBudget;
+        firstDfa = first.DFATranslate();
+        first.remove();
+        budget = parentBudget;
+
+        int status;
+        pid_t joined;
+        do {
+            joined = waitpid(worker, &status, 0);
+        } while(joined == -1 && errno == EINTR);
+        DFA* imported = nullptr;
+        if(joined == worker && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS) {
+            imported = dfaImport(path, nullptr, nullptr);
+        }
+        unlink(path);
+
+        // The sub-DAG of the second could have been shared and translated with the first one in the meantime
+        if(imported != nullptr && second.code->dfa == nullptr && !second.code->mark) {
+            second.code->dfa = imported;
+            second.code->mark = true;
+        } else if(imported != nullptr) {
+            dfaFree(imported);
+        }
+        secondDfa = second.DFATranslate();
+        second.remove();
+        return true;
+    }
+}
@@ -0,0 +1,32 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: ParallelTranslation.h
+ *  Description:
+ *      Concurrent translation of the MONA code DAG to DFA. The BDD managers
+ *      and the code table of MONA are global, hence the independent sub-DAG
+ *      of the binary node is translated in the forked worker process, that
+ *      exports the DFA to temporary file, while the parent translates the
+ *      other sub-DAG. Workers fork recursively (within the budget of the
+ *      processes), so the products are computed as the parallel reduction
+ *      tree of the DAG. Only sub-DAGs without common nodes are forked, and
+ *      never in the library mode, where the forked worker would inherit
+ *      the state of the embedding application.
+ *****************************************************************************/
+
+#ifndef WSKS_PARALLELTRANSLATION_H
+#define WSKS_PARALLELTRANSLATION_H
+
+#include "../../Frontend/code.h"
+
+namespace Gaston {
+    bool TranslateConcurrently(VarCode& first, DFA*& firstDfa, VarCode& second, DFA*& secondDfa);
+}
+
+#endif //WSKS_PARALLELTRANSLATION_H
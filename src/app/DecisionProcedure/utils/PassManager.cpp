@@ -0,0 +1,65 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: PassManager.cpp
+ *  Description:
+ *      Manager of the preprocessing passes over the formula. Measures the
+ *      time and number of formula nodes for each pass.
+ *****************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include "PassManager.h"
+
+/**
+ * Returns the statistics of pass with @p name, passes are kept in the order of their first run.
+ *
+ * @param[in] name:     name of the pass
+ * @return:             statistics of the pass
+ */
+PassManager::PassStats& PassManager::_GetStats(const char* name) {
+    for(auto it = this->_passes.begin(); it != this->_passes.end(); ++it) {
+        if(it->name == name) {
+            return *it;
+        }
+    }
+    this->_passes.emplace_back(name);
+    return this->_passes.back();
+}
+
+/**
+ * Computes the number of formula nodes of @p formula. The traversal of structural hash refreshes the sizes of
+ * the rewritten nodes.
+ *
+ * @param[in] formula:  measured formula
+ */
+void PassManager::_CountNodes(ASTForm* formula) {
+    formula->StructuralHash();
+    this->_formulaNodes = formula->size;
+    this->_isCounted = true;
+}
+
+/**
+ * Prints the time, number of runs and size of the formula for each of the passes
+ */
+void PassManager::DumpStats() {
+    std::uint64_t total = 0;
+    std::cout << "[*] Preprocessing passes:\n";
+    for(auto it = this->_passes.begin(); it != this->_passes.end(); ++it) {
+        total += it->nanoseconds;
+        std::cout << "\t\u2218 " << std::left << std::setw(28) << it->name << std::right;
+        std::cout << std::fixed << std::setprecision(3) << std::setw(10) << (it->nanoseconds / 1e6) << "ms";
+        std::cout << ", runs: " << it->runs;
+#       if (MEASURE_PREPROCESSING == true)
+        std::cout << ", nodes: " << it->nodesBefore << " -> " << it->nodesAfter;
+#       endif
+        std::cout << "\n";
+    }
+    std::cout << "[*] Preprocessing total: " << std::fixed << std::setprecision(3) << (total / 1e6) << "ms\n";
+}
@@ -0,0 +1,115 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: PassManager.h
+ *  Description:
+ *      Manager of the preprocessing passes over the formula. Measures the
+ *      time and number of formula nodes for each pass.
+ *****************************************************************************/
+
+#ifndef WSKS_PASSMANAGER_H
+#define WSKS_PASSMANAGER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../environment.hh"
+#include "../../Frontend/ast.h"
+#include "../../Frontend/env.h"
+#include "PhaseProfiler.h"
+
+extern Options options;
+
+class PassManager {
+public:
+    struct PassStats {
+        std::string name;
+        size_t runs = 0;
+        std::uint64_t nanoseconds = 0;
+        size_t nodesBefore = 0;
+        size_t nodesAfter = 0;
+
+        explicit PassStats(const char* n) : name(n) {}
+    };
+
+private:
+    // <<< PRIVATE MEMBERS >>>
+    std::vector<PassStats> _passes;
+    size_t _formulaNodes = 0;
+    bool _isCounted = false;
+
+    // <<< PRIVATE METHODS >>>
+    PassStats& _GetStats(const char* name);
+    void _CountNodes(ASTForm* formula);
+
+public:
+    // <<< PUBLIC API >>>
+    template<class Pass>
+    ASTForm* Transform(const char* name, ASTForm* formula, Pass& pass);
+    template<class Pass>
+    void Walk(const char* name, ASTForm* formula, Pass& pass);
+    void DumpStats();
+};
+
+/**
+ * Runs the transforming @p pass on @p formula
+ *
+ * @param[in] name:     name of the pass for statistics
+ * @param[in] formula:  transformed formula
+ * @param[in] pass:     transformer visitor
+ * @return:             transformed formula
+ */
+template<class Pass>
+ASTForm* PassManager::Transform(const char* name, ASTForm* formula, Pass& pass) {
+    PROFILE_PHASE(name);
+    PassStats& stats = this->_GetStats(name);
+#   if (MEASURE_PREPROCESSING == true)
+    if(options.time && !this->_isCounted) {
+        this->_CountNodes(formula);
+    }
+    stats.nodesBefore = this->_formulaNodes;
+#   endif
+
+    auto start = std::chrono::steady_clock::now();
+    formula = static_cast<ASTForm*>(formula->accept(pass));
+    // Passes rewrite the subformulae in place, so the memoized variables are no longer valid
+    ASTForm::InvalidateVarsCache();
+    stats.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    ++stats.runs;
+
+#   if (MEASURE_PREPROCESSING == true)
+    if(options.time) {
+        this->_CountNodes(formula);
+    }
+    stats.nodesAfter = this->_formulaNodes;
+#   endif
+    return formula;
+}
+
+/**
+ * Runs the non-transforming @p pass on @p formula. Such passes modify only the annotations of nodes (e.g. tags).
+ *
+ * @param[in] name:     name of the pass for statistics
+ * @param[in] formula:  traversed formula
+ * @param[in] pass:     void visitor
+ */
+template<class Pass>
+void PassManager::Walk(const char* name, ASTForm* formula, Pass& pass) {
+    PROFILE_PHASE(name);
+    PassStats& stats = this->_GetStats(name);
+
+    auto start = std::chrono::steady_clock::now();
+    formula->accept(pass);
+    stats.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    ++stats.runs;
+    stats.nodesBefore = stats.nodesAfter = this->_formulaNodes;
+}
+
+#endif //WSKS_PASSMANAGER_H
@@ -0,0 +1,209 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: PhaseProfiler.cpp
+ *  Description:
+ *      Profiling of the phases of the procedure (parsing, preprocessing
+ *      passes, construction of base automata, deciding). Phases can be
+ *      nested, repeated phases with the same parent are aggregated. Each
+ *      phase measures the monotonic time in nanoseconds and samples the
+ *      resident set size and its peak from /proc/self/status. The
+ *      profiler is disabled, unless it is enabled by --time or --profile.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include "PhaseProfiler.h"
+
+namespace Gaston {
+    PhaseProfiler profiler;
+
+    namespace {
+        /**
+         * Reads the values (in kB) of the @p keys from /proc/self/status in one pass, the values that are not
+         * available are 0
+         */
+        void readStatus(const char* const keys[], long values[], size_t count) {
+            std::fill(values, values + count, 0);
+            FILE* status = fopen("/proc/self/status", "r");
+            if(status == nullptr) {
+                return;
+            }
+
+            char line[256];
+            size_t found = 0;
+            while(found < count && fgets(line, sizeof(line), status) != nullptr) {
+                for(size_t i = 0; i < count; ++i) {
+                    size_t keyLength = strlen(keys[i]);
+                    if(strncmp(line, keys[i], keyLength) == 0 && line[keyLength] == ':') {
+                        values[i] = strtol(line + keyLength + 1, nullptr, 10);
+                        ++found;
+                        break;
+                    }
+                }
+            }
+            fclose(status);
+        }
+
+        long readStatus(const char* key) {
+            long value;
+            readStatus(&key, &value, 1);
+            return value;
+        }
+    }
+
+    std::uint64_t PhaseProfiler::Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    long PhaseProfiler::CurrentRss() {
+        return readStatus("VmRSS");
+    }
+
+    long PhaseProfiler::PeakRss() {
+        return readStatus("VmHWM");
+    }
+
+    /**
+     * Returns the phase @p name nested in the currently open phase, the phase is created if it was not entered yet
+     */
+    size_t PhaseProfiler::_FindPhase(const char* name) {
+        size_t parent = this->_stack.empty() ? NoParent : this->_stack.back().phase;
+        for(size_t i = 0; i < this->_phases.size(); ++i) {
+            if(this->_phases[i].parent == parent && this->_phases[i].name == name) {
+                return i;
+            }
+        }
+        this->_phases.emplace_back(name, parent, this->_stack.size());
+        return this->_phases.size() - 1;
+    }
+
+    /**
+     * Samples the RSS and the high-water mark of the process and propagates the RSS to the peaks of all of the open
+     * phases. The high-water mark of the process is never reset (it is reported by the wait4 and time of the
+     * callers), so the peaks of phases are the maxima of the samples taken at the boundaries of their nested
+     * phases, unless the high-water mark grew during the phase (see Leave()).
+     *
+     * @return:     current RSS and high-water mark in kB
+     */
+    PhaseProfiler::Sample PhaseProfiler::_Sample() {
+        static const char* const keys[] = {"VmRSS", "VmHWM"};
+        long values[2];
+        readStatus(keys, values, 2);
+
+        Sample sample{values[0], values[1]};
+        this->_processPeak = std::max(this->_processPeak, sample.hwm);
+        for(auto& open : this->_stack) {
+            open.peak = std::max(open.peak, sample.rss);
+        }
+        return sample;
+    }
+
+    /**
+     * Enters the phase @p name, nested in the currently open phase
+     *
+     * @param[in] name:     name of the phase
+     */
+    void PhaseProfiler::Enter(const char* name) {
+        Sample sample = this->_Sample();
+        size_t phase = this->_FindPhase(name);
+        if(this->_phases[phase].calls == 0) {
+            this->_phases[phase].rssBefore = sample.rss;
+        }
+        this->_stack.push_back(OpenPhase{phase, Now(), sample.rss, sample.hwm});
+    }
+
+    /**
+     * Leaves the most nested open phase. If the high-water mark of the process grew during the phase, the new
+     * high-water mark was reached in the phase, so it is its peak.
+     */
+    void PhaseProfiler::Leave() {
+        assert(!this->_stack.empty());
+        std::uint64_t end = Now();
+        Sample sample = this->_Sample();
+
+        OpenPhase open = this->_stack.back();
+        this->_stack.pop_back();
+        Phase& phase = this->_phases[open.phase];
+        phase.nanoseconds += end - open.start;
+        ++phase.calls;
+        phase.rssAfter = sample.rss;
+        phase.peakRss = std::max(phase.peakRss, (sample.hwm > open.hwmBefore) ? sample.hwm : open.peak);
+    }
+
+    /**
+     * Returns the path of the @p phase, i.e. names of the phases it is nested in, separated by '/'
+     */
+    std::string PhaseProfiler::_Path(size_t phase) {
+        std::string path(this->_phases[phase].name);
+        for(size_t p = this->_phases[phase].parent; p != NoParent; p = this->_phases[p].parent) {
+            path = this->_phases[p].name + "/" + path;
+        }
+        return path;
+    }
+
+    void PhaseProfiler::_DumpPhase(size_t phase) {
+        Phase& p = this->_phases[phase];
+        std::cout << "\t\u2218 " << std::string(2*p.depth, ' ') << std::left << std::setw(32 - 2*p.depth) << p.name << std::right;
+        std::cout << std::fixed << std::setprecision(3) << std::setw(12) << (p.nanoseconds / 1e6) << "ms";
+        std::cout << ", calls: " << p.calls;
+        std::cout << ", rss: " << (p.rssBefore / 1024) << "MB -> " << (p.rssAfter / 1024) << "MB";
+        std::cout << ", peak: " << (p.peakRss / 1024) << "MB\n";
+
+        for(size_t i = phase + 1; i < this->_phases.size(); ++i) {
+            if(this->_phases[i].parent == phase) {
+                this->_DumpPhase(i);
+            }
+        }
+    }
+
+    /**
+     * Prints the tree of phases with their times and memory
+     */
+    void PhaseProfiler::Dump() {
+        std::cout << "[*] Phases:\n";
+        for(size_t i = 0; i < this->_phases.size(); ++i) {
+            if(this->_phases[i].parent == NoParent) {
+                this->_DumpPhase(i);
+            }
+        }
+        std::cout << "[*] Peak RSS: " << (std::max(this->_processPeak, PeakRss()) / 1024) << "MB\n";
+    }
+
+    /**
+     * Exports the phases to JSON file @p path
+     *
+     * @param[in] path:     path of the output file
+     * @return:             false if the file could not be written
+     */
+    bool PhaseProfiler::ExportJSON(const char* path) {
+        FILE* out = fopen(path, "w");
+        if(out == nullptr) {
+            std::cerr << "[!] Cannot write phase profile to '" << path << "'\n";
+            return false;
+        }
+
+        fprintf(out, "{\"peakRssKB\":%ld,\"phases\":[", std::max(this->_processPeak, PeakRss()));
+        for(size_t i = 0; i < this->_phases.size(); ++i) {
+            Phase& p = this->_phases[i];
+            fprintf(out, "%s\n{\"name\":\"%s\",\"path\":\"%s\",\"depth\":%zu,\"calls\":%zu,\"ns\":%llu,"
+                    "\"rssBeforeKB\":%ld,\"rssAfterKB\":%ld,\"peakRssKB\":%ld}", (i == 0 ? "" : ","),
+                    p.name.c_str(), this->_Path(i).c_str(), p.depth, p.calls, static_cast<unsigned long long>(p.nanoseconds),
+                    p.rssBefore, p.rssAfter, p.peakRss);
+        }
+        fprintf(out, "\n]}\n");
+        return fclose(out) == 0;
+    }
+}
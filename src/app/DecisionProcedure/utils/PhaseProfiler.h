@@ -0,0 +1,117 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: PhaseProfiler.h
+ *  Description:
+ *      Profiling of the phases of the procedure (parsing, preprocessing
+ *      passes, construction of base automata, deciding). Phases can be
+ *      nested, repeated phases with the same parent are aggregated. Each
+ *      phase measures the monotonic time in nanoseconds and samples the
+ *      resident set size and its peak from /proc/self/status. The
+ *      profiler is disabled, unless it is enabled by --time or --profile.
+ *****************************************************************************/
+
+#ifndef WSKS_PHASEPROFILER_H
+#define WSKS_PHASEPROFILER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../environment.hh"
+
+// <<< MACROS >>>
+#if (MEASURE_PHASES == true)
+#   define PROFILE_PHASE(name) Gaston::PhaseScope phaseScope(name)
+#else
+#   define PROFILE_PHASE(name)
+#endif
+
+namespace Gaston {
+    class PhaseProfiler {
+    public:
+        static const size_t NoParent = static_cast<size_t>(-1);
+
+        struct Phase {
+            std::string name;
+            size_t parent;
+            size_t depth;
+            size_t calls = 0;
+            std::uint64_t nanoseconds = 0;
+            long rssBefore = 0;             // << RSS in kB at the first entry of the phase
+            long rssAfter = 0;              // << RSS in kB at the last exit of the phase
+            long peakRss = 0;               // << Peak RSS in kB during the phase (lower bound, see _Sample)
+
+            Phase(std::string n, size_t p, size_t d) : name(n), parent(p), depth(d) {}
+        };
+
+    private:
+        // <<< PRIVATE MEMBERS >>>
+        struct OpenPhase {
+            size_t phase;
+            std::uint64_t start;
+            long peak;                      // << Peak of the RSS samples taken during the phase
+            long hwmBefore;                 // << High-water mark of the process at the entry
+        };
+
+        struct Sample {
+            long rss;                       // << VmRSS in kB
+            long hwm;                       // << VmHWM in kB
+        };
+
+        std::vector<Phase> _phases;
+        std::vector<OpenPhase> _stack;
+        long _processPeak = 0;
+        bool _enabled = false;
+
+        // <<< PRIVATE METHODS >>>
+        size_t _FindPhase(const char* name);
+        Sample _Sample();
+        std::string _Path(size_t phase);
+        void _DumpPhase(size_t phase);
+
+    public:
+        // <<< PUBLIC API >>>
+        void Enable() { this->_enabled = true; }
+        bool IsEnabled() const { return this->_enabled; }
+        void Enter(const char* name);
+        void Leave();
+        const std::vector<Phase>& GetPhases() const { return this->_phases; }
+        long GetProcessPeak() const { return this->_processPeak; }
+        void Dump();
+        bool ExportJSON(const char* path);
+
+        static std::uint64_t Now();
+        static long CurrentRss();
+        static long PeakRss();
+    };
+
+    extern PhaseProfiler profiler;
+
+    /**
+     * Scope of the phase, the phase is left at the end of the scope
+     */
+    class PhaseScope {
+    public:
+        explicit PhaseScope(const char* name) : _entered(profiler.IsEnabled()) {
+            if(this->_entered) {
+                profiler.Enter(name);
+            }
+        }
+        ~PhaseScope() {
+            if(this->_entered) {
+                profiler.Leave();
+            }
+        }
+
+    private:
+        bool _entered;
+    };
+}
+
+#endif //WSKS_PHASEPROFILER_H
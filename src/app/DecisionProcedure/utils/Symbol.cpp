@@ -20,6 +20,15 @@
 
 extern VarToTrackMap varMap;
 
+#if (MEASURE_MEMORY == true)
+/**
+ * Returns the number of bytes occupied by the symbol with @p track, i.e. the symbol itself and blocks of its track
+ */
+static size_t symbolFootprint(BitMask const& track) {
+    return sizeof(ZeroSymbol) + track.num_blocks()*sizeof(BitMask::block_type);
+}
+#endif
+
 namespace Gaston {
     size_t hash_value(ZeroSymbol* s) {
 #       if (OPT_SYMBOL_HASH_BY_APPROX == true)
@@ -44,6 +53,9 @@ ZeroSymbol::ZeroSymbol() : _trackMask(varMap.TrackLength() << 1) {
     ++ZeroSymbol::instances;
 #   endif
     this->_bdd = nullptr;
+#   if (MEASURE_MEMORY == true)
+    Gaston::Memory::Allocate(Gaston::Memory::Symbols, symbolFootprint(this->_trackMask));
+#   endif
 }
 
 /**
@@ -57,6 +69,9 @@ ZeroSymbol::ZeroSymbol(BitMask const& track) {
 #   endif
     this->_trackMask = track;
     this->_bdd = nullptr;
+#   if (MEASURE_MEMORY == true)
+    Gaston::Memory::Allocate(Gaston::Memory::Symbols, symbolFootprint(this->_trackMask));
+#   endif
 }
 
 /**
@@ -74,6 +89,9 @@ ZeroSymbol::ZeroSymbol(BitMask const& track, VarType var, VarValue val) {
     this->_trackMask = track;
     this->_SetValueAt(var, ZeroSymbol::charToAsgn(val));
     this->_bdd = nullptr;
+#   if (MEASURE_MEMORY == true)
+    Gaston::Memory::Allocate(Gaston::Memory::Symbols, symbolFootprint(this->_trackMask));
+#   endif
 }
 
 ZeroSymbol::ZeroSymbol(ZeroSymbol* src, std::map<unsigned int, unsigned int>* map)  : _trackMask(varMap.TrackLength() << 1) {
@@ -85,9 +103,15 @@ ZeroSymbol::ZeroSymbol(ZeroSymbol* src, std::map<unsigned int, unsigned int>* ma
         this->_SetValueAt(to, src->GetSymbolAt(from));
     }
     this->_bdd = nullptr;
+#   if (MEASURE_MEMORY == true)
+    Gaston::Memory::Allocate(Gaston::Memory::Symbols, symbolFootprint(this->_trackMask));
+#   endif
 }
 
 ZeroSymbol::~ZeroSymbol() {
+#   if (MEASURE_MEMORY == true)
+    Gaston::Memory::Free(Gaston::Memory::Symbols, symbolFootprint(this->_trackMask));
+#   endif
     if(this->_bdd != nullptr) {
         delete this->_bdd;
         this->_bdd = nullptr;
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: Tracer.cpp
+ *  Description:
+ *      Timeline of the decision procedure. Spans of the computation (e.g.
+ *      IntersectNonEmpty on each node of the automaton) are recorded into
+ *      per-thread ring buffers and written as Chrome trace-event JSON, that
+ *      can be opened in chrome://tracing or Perfetto. Tracing is enabled by
+ *      --trace=<file>, otherwise each span costs one test of a flag.
+ *****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "Tracer.h"
+
+namespace Gaston {
+namespace Trace {
+    bool enabled = false;
+
+    namespace {
+        std::string tracePath;
+        size_t bufferCapacity = DefaultCapacity;
+        std::chrono::steady_clock::time_point traceStart;
+        std::mutex buffersLock;
+        std::vector<std::unique_ptr<RingBuffer>> buffers;
+        thread_local RingBuffer* threadBuffer = nullptr;
+
+        const char* kindNames[] = {"SymbolicBase", "Binary", "Intersection", "Union", "Projection", "Base", "Complement"};
+    }
+
+    RingBuffer::RingBuffer(size_t threadId, size_t capacity) : _events(capacity), _threadId(threadId) {}
+
+    /**
+     * Pushes the @p event to the buffer, if the buffer is full, the oldest event is overwritten
+     *
+     * @param[in] event:    recorded span
+     */
+    void RingBuffer::Push(const Event& event) {
+        if(this->_wrapped) {
+            ++this->_dropped;
+        }
+        this->_events[this->_next] = event;
+        if(++this->_next == this->_events.size()) {
+            this->_next = 0;
+            this->_wrapped = true;
+        }
+    }
+
+    /**
+     * Returns the @p i-th oldest event in the buffer
+     */
+    const Event& RingBuffer::operator[](size_t i) const {
+        return !this->_wrapped ? this->_events[i] : this->_events[(this->_next + i) % this->_events.size()];
+    }
+
+    /**
+     * Enables the tracing, the trace will be written to @p path by Flush()
+     *
+     * @param[in] path:         path to the output JSON file
+     * @param[in] capacity:     number of events kept per thread
+     */
+    void Enable(const char* path, size_t capacity) {
+        tracePath = path;
+        bufferCapacity = capacity;
+        traceStart = std::chrono::steady_clock::now();
+        enabled = true;
+    }
+
+    /**
+     * Returns nanoseconds since the tracing was enabled
+     */
+    uint64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceStart).count();
+    }
+
+    /**
+     * Returns the buffer of the calling thread, the buffer is allocated on the first use
+     */
+    RingBuffer& ThreadBuffer() {
+        if(threadBuffer == nullptr) {
+            std::lock_guard<std::mutex> guard(buffersLock);
+            buffers.emplace_back(new RingBuffer(buffers.size(), bufferCapacity));
+            threadBuffer = buffers.back().get();
+        }
+        return *threadBuffer;
+    }
+
+    /**
+     * Writes the events of all threads as Chrome trace-event JSON and disables the tracing
+     */
+    void Flush() {
+        if(!enabled) {
+            return;
+        }
+        enabled = false;
+
+        FILE* out = fopen(tracePath.c_str(), "w");
+        if(out == nullptr) {
+            std::cerr << "[!] Cannot write trace to '" << tracePath << "'\n";
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(buffersLock);
+        size_t dropped = 0;
+        bool first = true;
+        fprintf(out, "{\"traceEvents\":[\n");
+        for(auto& buffer : buffers) {
+            fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%zu,\"args\":{\"name\":\"gaston-%zu\"}}",
+                    (first ? "" : ",\n"), buffer->ThreadId(), buffer->ThreadId());
+            first = false;
+            for(size_t i = 0; i < buffer->Size(); ++i) {
+                const Event& event = (*buffer)[i];
+                fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"gaston\",\"ph\":\"X\",\"pid\":0,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"node\":\"%p\"",
+                        event.name, buffer->ThreadId(), event.start / 1000.0, event.duration / 1000.0, event.node);
+                if(event.kind != NoKind) {
+                    fprintf(out, ",\"aut\":\"%s\"", kindNames[event.kind]);
+                }
+                fprintf(out, "}}");
+            }
+            dropped += buffer->Dropped();
+        }
+        fprintf(out, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":%zu}}\n", dropped);
+        fclose(out);
+
+        if(dropped != 0) {
+            std::cerr << "[!] Trace buffers overflowed, " << dropped << " oldest events were dropped\n";
+        }
+    }
+}
+}
@@ -0,0 +1,99 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: Tracer.h
+ *  Description:
+ *      Timeline of the decision procedure. Spans of the computation (e.g.
+ *      IntersectNonEmpty on each node of the automaton) are recorded into
+ *      per-thread ring buffers and written as Chrome trace-event JSON, that
+ *      can be opened in chrome://tracing or Perfetto. Tracing is enabled by
+ *      --trace=<file>, otherwise each span costs one test of a flag.
+ *****************************************************************************/
+
+#ifndef WSKS_TRACER_H
+#define WSKS_TRACER_H
+
+#include <cstdint>
+#include <vector>
+#include "../environment.hh"
+
+// <<< MACROS >>>
+#if (MEASURE_TRACE == true)
+#   define TRACE_SPAN(name, node, kind) Gaston::Trace::Span traceSpan(name, node, kind)
+#else
+#   define TRACE_SPAN(name, node, kind)
+#endif
+
+namespace Gaston {
+namespace Trace {
+    static const int NoKind = -1;
+    static const size_t DefaultCapacity = 1 << 20;
+
+    struct Event {
+        const char* name;       // << Name of the span, has to be static string
+        const void* node;       // << Automaton or term the span belongs to
+        int kind;               // << AutType of the node or NoKind
+        uint64_t start;         // << Start of the span in ns since the trace was enabled
+        uint64_t duration;      // << Duration of the span in ns
+    };
+
+    class RingBuffer {
+    private:
+        // <<< PRIVATE MEMBERS >>>
+        std::vector<Event> _events;
+        size_t _next = 0;
+        size_t _dropped = 0;
+        bool _wrapped = false;
+        size_t _threadId;
+
+    public:
+        // <<< CONSTRUCTORS >>>
+        RingBuffer(size_t threadId, size_t capacity);
+
+        // <<< PUBLIC API >>>
+        void Push(const Event& event);
+        size_t Size() const { return this->_wrapped ? this->_events.size() : this->_next; }
+        size_t Dropped() const { return this->_dropped; }
+        size_t ThreadId() const { return this->_threadId; }
+        const Event& operator[](size_t i) const;
+    };
+
+    extern bool enabled;
+
+    void Enable(const char* path, size_t capacity = DefaultCapacity);
+    void Flush();
+    uint64_t Now();
+    RingBuffer& ThreadBuffer();
+
+    /**
+     * Scoped span of the computation, the event is recorded when the span is left
+     */
+    class Span {
+    private:
+        const char* _name;
+        const void* _node;
+        int _kind;
+        uint64_t _start;
+        bool _active;
+
+    public:
+        Span(const char* name, const void* node, int kind = NoKind) : _name(name), _node(node), _kind(kind), _active(enabled) {
+            this->_start = this->_active ? Now() : 0;
+        }
+
+        ~Span() {
+            if(this->_active) {
+                ThreadBuffer().Push(Event{this->_name, this->_node, this->_kind, this->_start, Now() - this->_start});
+            }
+        }
+    };
+}
+}
+
+#endif //WSKS_TRACER_H
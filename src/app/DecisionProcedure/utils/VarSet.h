@@ -0,0 +1,80 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: VarSet.h
+ *  Description:
+ *      Dense set of variables (identifiers of the symbol table) represented
+ *      by bitset. Unlike IdentList, whose membership walks the list, the
+ *      membership is tested by a single bit.
+ *****************************************************************************/
+
+#ifndef WSKS_VARSET_H
+#define WSKS_VARSET_H
+
+#include <boost/dynamic_bitset.hpp>
+#include "../../Frontend/ident.h"
+
+class VarSet {
+public:
+    // <<< PUBLIC CONSTRUCTORS >>>
+    VarSet() {}
+    explicit VarSet(IdentList* vars) { this->Insert(vars); }
+
+    // <<< PUBLIC API >>>
+    bool Contains(Ident var) const {
+        return static_cast<size_t>(var) < this->_vars.size() && this->_vars.test(var);
+    }
+    bool IsEmpty() const { return this->_vars.none(); }
+
+    void Insert(Ident var) {
+        if(static_cast<size_t>(var) >= this->_vars.size()) {
+            this->_vars.resize(var + 1);
+        }
+        this->_vars.set(var);
+    }
+
+    void Insert(IdentList* vars) {
+        if(vars == nullptr)
+            return;
+        for(auto it = vars->begin(); it != vars->end(); ++it) {
+            this->Insert(*it);
+        }
+    }
+
+    /**
+     * Calls @p f for each of the variables of the set in the ascending order
+     *
+     * @param[in] f:    function taking the Ident
+     */
+    template<class Function>
+    void ForEach(Function f) const {
+        for(size_t i = this->_vars.find_first(); i != boost::dynamic_bitset<>::npos; i = this->_vars.find_next(i)) {
+            f(static_cast<Ident>(i));
+        }
+    }
+
+    /**
+     * @return: sorted list of the variables of the set (owned by the caller), nullptr if empty, as ident_union
+     */
+    IdentList* ToIdentList() const {
+        if(this->IsEmpty())
+            return nullptr;
+        IdentList* list = new IdentList();
+        for(size_t i = this->_vars.find_first(); i != boost::dynamic_bitset<>::npos; i = this->_vars.find_next(i)) {
+            list->push_back(static_cast<Ident>(i));
+        }
+        return list;
+    }
+
+private:
+    // <<< PRIVATE MEMBERS >>>
+    boost::dynamic_bitset<> _vars;
+};
+
+#endif //WSKS_VARSET_H
@@ -0,0 +1,186 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: VariableOrdering.cpp
+ *  Description:
+ *      Computation of the order of variables (i.e. tracks and BDD indices)
+ *      by FORCE heuristic over the hypergraph of variables co-occurring in
+ *      the atomic formulae. Variables that interact closely are placed next
+ *      to each other, which yields smaller BDDs of the base automata.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include "VariableOrdering.h"
+
+/**
+ * Constructs the hypergraph of variables, where each atomic formula of @p formula induces one hyperedge over its
+ * variables. Only the variables from @p vars are considered.
+ *
+ * @param[in] formula:  formula, whose atoms are collected
+ * @param[in] vars:     list of variables, that will be ordered
+ */
+VariableOrdering::VariableOrdering(ASTForm* formula, IdentList* vars) {
+    assert(formula != nullptr);
+    assert(vars != nullptr);
+
+    for(auto it = vars->begin(); it != vars->end(); ++it) {
+        if(this->_varIndex.find(*it) == this->_varIndex.end()) {
+            this->_varIndex.insert(std::make_pair(*it, this->_vars.size()));
+            this->_vars.push_back(*it);
+        }
+    }
+    this->_CollectEdges(formula);
+}
+
+/**
+ * Recursively collects the hyperedges from atoms of @p form
+ *
+ * @param[in] form:     traversed formula
+ */
+void VariableOrdering::_CollectEdges(ASTForm* form) {
+    switch(form->kind) {
+        case aAnd:
+        case aOr:
+        case aImpl:
+        case aBiimpl:
+        case aIdLeft:
+            this->_CollectEdges(static_cast<ASTForm_ff*>(form)->f1);
+            this->_CollectEdges(static_cast<ASTForm_ff*>(form)->f2);
+            break;
+        case aNot:
+            this->_CollectEdges(static_cast<ASTForm_Not*>(form)->f);
+            break;
+        case aEx0:
+        case aAll0:
+            this->_CollectEdges(static_cast<ASTForm_vf*>(form)->f);
+            break;
+        case aEx1:
+        case aEx2:
+        case aAll1:
+        case aAll2:
+            this->_CollectEdges(static_cast<ASTForm_uvf*>(form)->f);
+            break;
+        default:
+            this->_AddEdge(form);
+            break;
+    }
+}
+
+/**
+ * Adds the hyperedge over the variables of @p atom. Edges over less than two variables do not constrain the order.
+ *
+ * @param[in] atom:     atomic formula
+ */
+void VariableOrdering::_AddEdge(ASTForm* atom) {
+    IdentList free, bound;
+    atom->freeVarsCached(&free, &bound);
+
+    Edge edge;
+    for(auto it = free.begin(); it != free.end(); ++it) {
+        auto var = this->_varIndex.find(*it);
+        if(var != this->_varIndex.end()) {
+            edge.push_back(var->second);
+        }
+    }
+
+    if(edge.size() > 1) {
+        this->_edges.push_back(std::move(edge));
+    }
+}
+
+/**
+ * @param[in] position:     position of each variable in the order
+ * @return:                 the total span of all hyperedges, i.e. the sum of distances between their extreme variables
+ */
+size_t VariableOrdering::_Span(std::vector<size_t>& position) {
+    size_t span = 0;
+    for(auto& edge : this->_edges) {
+        size_t min = position[edge.front()], max = min;
+        for(auto var : edge) {
+            min = std::min(min, position[var]);
+            max = std::max(max, position[var]);
+        }
+        span += max - min;
+    }
+    return span;
+}
+
+/**
+ * Computes the order of variables by the FORCE heuristic: each hyperedge pulls its variables towards its center
+ * of gravity and the variables are sorted by the average of the centers of their edges. The iteration stops once
+ * the total span of hyperedges no longer decreases. The initial order is the order of identifiers, i.e. the order
+ * of declaration, which is kept for variables that do not occur in any edge.
+ *
+ * @return: new list of variables in the order of their tracks
+ */
+IdentList* VariableOrdering::ComputeOrder() {
+    size_t varNum = this->_vars.size();
+    std::vector<size_t> order(varNum);
+    std::vector<size_t> position(varNum);
+    for(size_t i = 0; i < varNum; ++i) {
+        order[i] = position[i] = i;
+    }
+
+    this->_initialSpan = this->_finalSpan = this->_Span(position);
+    std::vector<double> gravity(varNum);
+    std::vector<size_t> degree(varNum);
+    std::vector<size_t> newOrder(varNum);
+    std::vector<size_t> newPosition(varNum);
+    for(this->_iterations = 0; this->_iterations < MaxIterations && this->_finalSpan != 0; ++this->_iterations) {
+        std::fill(gravity.begin(), gravity.end(), 0.0);
+        std::fill(degree.begin(), degree.end(), 0);
+        for(auto& edge : this->_edges) {
+            double center = 0.0;
+            for(auto var : edge) {
+                center += position[var];
+            }
+            center /= edge.size();
+            for(auto var : edge) {
+                gravity[var] += center;
+                ++degree[var];
+            }
+        }
+        for(size_t var = 0; var < varNum; ++var) {
+            gravity[var] = (degree[var] == 0) ? position[var] : gravity[var] / degree[var];
+        }
+
+        newOrder = order;
+        std::stable_sort(newOrder.begin(), newOrder.end(), [&gravity](size_t lhs, size_t rhs) {
+            return gravity[lhs] < gravity[rhs];
+        });
+        for(size_t i = 0; i < varNum; ++i) {
+            newPosition[newOrder[i]] = i;
+        }
+
+        size_t span = this->_Span(newPosition);
+        if(span >= this->_finalSpan) {
+            break;
+        }
+        this->_finalSpan = span;
+        order.swap(newOrder);
+        position.swap(newPosition);
+    }
+
+    IdentList* ordered = new IdentList();
+    for(auto var : order) {
+        ordered->push_back(this->_vars[var]);
+    }
+    return ordered;
+}
+
+/**
+ * Prints the statistics of the ordering
+ */
+void VariableOrdering::DumpStats() {
+    std::cout << "[*] Variable ordering statistics\n";
+    std::cout << "\t\u2218 Variables: " << this->_vars.size() << ", edges: " << this->_edges.size() << "\n";
+    std::cout << "\t\u2218 Total span of edges: " << this->_initialSpan << " -> " << this->_finalSpan;
+    std::cout << " (" << this->_iterations << " iterations)\n";
+}
@@ -0,0 +1,54 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: VariableOrdering.h
+ *  Description:
+ *      Computation of the order of variables (i.e. tracks and BDD indices)
+ *      by FORCE heuristic over the hypergraph of variables co-occurring in
+ *      the atomic formulae. Variables that interact closely are placed next
+ *      to each other, which yields smaller BDDs of the base automata.
+ *****************************************************************************/
+
+#ifndef WSKS_VARIABLEORDERING_H
+#define WSKS_VARIABLEORDERING_H
+
+#include <vector>
+#include <unordered_map>
+#include "../environment.hh"
+#include "../../Frontend/ast.h"
+#include "../../Frontend/ident.h"
+
+class VariableOrdering {
+private:
+    // <<< PRIVATE MEMBERS >>>
+    using Edge = std::vector<size_t>;
+    static const size_t MaxIterations = 32;
+
+    std::vector<Ident> _vars;
+    std::unordered_map<Ident, size_t> _varIndex;
+    std::vector<Edge> _edges;
+    size_t _initialSpan = 0;
+    size_t _finalSpan = 0;
+    size_t _iterations = 0;
+
+    // <<< PRIVATE METHODS >>>
+    void _CollectEdges(ASTForm* form);
+    void _AddEdge(ASTForm* atom);
+    size_t _Span(std::vector<size_t>& position);
+
+public:
+    // <<< CONSTRUCTORS >>>
+    VariableOrdering(ASTForm* formula, IdentList* vars);
+
+    // <<< PUBLIC API >>>
+    IdentList* ComputeOrder();
+    void DumpStats();
+};
+
+#endif //WSKS_VARIABLEORDERING_H
@@ -16,6 +16,7 @@
 #include "NegationUnfolder.h"
 #include "UniversalQuantifierRemover.h"
 #include "../../Frontend/ast.h"
+#include "../utils/VarSet.h"
 
 /**
  * @param[in] form:     traversed Ex0 node
@@ -97,10 +98,11 @@ ASTForm* FullAntiPrenexer::distributiveRule(QuantifierClass *qForm) {
     IdentList free2, bound2;
     binopForm->f1->freeVars(&free1, &bound1);
     binopForm->f2->freeVars(&free2, &bound2);
+    VarSet freeLeft(&free1), freeRight(&free2);
 
     for (auto var = bound->begin(); var != bound->end(); ++var) {
-        bool varInLeft = free1.exists(*var);
-        bool varInRight = free2.exists(*var);
+        bool varInLeft = freeLeft.Contains(*var);
+        bool varInRight = freeRight.Contains(*var);
 
         if(varInLeft) {
             left.push_back(*var);
@@ -144,10 +146,11 @@ ASTForm* FullAntiPrenexer::nonDistributiveRule(QuantifierClass *qForm) {
     IdentList free2, bound2;
     binopForm->f1->freeVars(&free1, &bound1);
     binopForm->f2->freeVars(&free2, &bound2);
+    VarSet freeLeft(&free1), freeRight(&free2);
 
     for (auto var = bound->begin(); var != bound->end(); ++var) {
-        bool varInLeft = free1.exists(*var);
-        bool varInRight = free2.exists(*var);
+        bool varInLeft = freeLeft.Contains(*var);
+        bool varInRight = freeRight.Contains(*var);
 
         // Ex var. f1 op f2     | var in f1 && var in f2
         if (varInLeft && varInRight) {
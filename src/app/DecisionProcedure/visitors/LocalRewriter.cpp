@@ -0,0 +1,80 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Fused local rewriting of the formula: applies the boolean laws of
+ *    BooleanUnfolder, removal of universal quantifiers of
+ *    UniversalQuantifierRemover and pushing of negations of NegationUnfolder
+ *    in one bottom-up traversal instead of three.
+ *
+ *****************************************************************************/
+
+#include "LocalRewriter.h"
+
+/**
+ * Pushes the negation deeper if the @p form is negation, otherwise does nothing. The children of @p form are
+ * already rewritten, so this is the same as if the NegationUnfolder visited the node in its own traversal.
+ *
+ * @param[in] form:     rewritten node
+ * @return:             node with pushed negation
+ */
+AST* LocalRewriter::_PushNegation(AST* form) {
+    if(form->kind == aNot) {
+        return this->_negationUnfolder.visit(static_cast<ASTForm_Not*>(form));
+    } else {
+        return form;
+    }
+}
+
+/**
+ * Pushes the negations introduced by removal of universal quantifier, i.e. for the result of form
+ * not ex X. not phi pushes the inner negation into phi and then tries the outer one.
+ *
+ * @param[in] form:     result of UniversalQuantifierRemover
+ * @return:             node with pushed negations
+ */
+AST* LocalRewriter::_RemoveUniversal(AST* form) {
+    assert(form->kind == aNot);
+    ASTForm_Not* outerNeg = static_cast<ASTForm_Not*>(form);
+    ASTForm_q* exists = static_cast<ASTForm_q*>(outerNeg->f);
+    exists->f = static_cast<ASTForm*>(this->_PushNegation(exists->f));
+    return this->_PushNegation(outerNeg);
+}
+
+AST* LocalRewriter::visit(ASTForm_And* form) {
+    return this->_PushNegation(this->_booleanUnfolder.visit(form));
+}
+
+AST* LocalRewriter::visit(ASTForm_Or* form) {
+    return this->_PushNegation(this->_booleanUnfolder.visit(form));
+}
+
+AST* LocalRewriter::visit(ASTForm_Not* form) {
+    return this->_PushNegation(this->_booleanUnfolder.visit(form));
+}
+
+AST* LocalRewriter::visit(ASTForm_Impl* form) {
+    return this->_PushNegation(this->_booleanUnfolder.visit(form));
+}
+
+AST* LocalRewriter::visit(ASTForm_Biimpl* form) {
+    return this->_PushNegation(this->_booleanUnfolder.visit(form));
+}
+
+AST* LocalRewriter::visit(ASTForm_All0* form) {
+    return this->_RemoveUniversal(this->_quantifierRemover.visit(form));
+}
+
+AST* LocalRewriter::visit(ASTForm_All1* form) {
+    return this->_RemoveUniversal(this->_quantifierRemover.visit(form));
+}
+
+AST* LocalRewriter::visit(ASTForm_All2* form) {
+    return this->_RemoveUniversal(this->_quantifierRemover.visit(form));
+}
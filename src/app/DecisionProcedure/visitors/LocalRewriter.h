@@ -0,0 +1,49 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Fused local rewriting of the formula: applies the boolean laws of
+ *    BooleanUnfolder, removal of universal quantifiers of
+ *    UniversalQuantifierRemover and pushing of negations of NegationUnfolder
+ *    in one bottom-up traversal instead of three.
+ *
+ *****************************************************************************/
+
+#ifndef WSKS_LOCALREWRITER_H
+#define WSKS_LOCALREWRITER_H
+
+#include "../../Frontend/ast.h"
+#include "../../Frontend/ast_visitor.h"
+#include "BooleanUnfolder.h"
+#include "NegationUnfolder.h"
+#include "UniversalQuantifierRemover.h"
+
+class LocalRewriter : public TransformerVisitor {
+private:
+    BooleanUnfolder _booleanUnfolder;
+    UniversalQuantifierRemover _quantifierRemover;
+    NegationUnfolder _negationUnfolder;
+
+    AST* _PushNegation(AST* form);
+    AST* _RemoveUniversal(AST* form);
+
+public:
+    LocalRewriter() : TransformerVisitor(Traverse::PostOrder) {}
+
+    AST* visit(ASTForm_And* form);
+    AST* visit(ASTForm_Or* form);
+    AST* visit(ASTForm_Not* form);
+    AST* visit(ASTForm_Impl* form);
+    AST* visit(ASTForm_Biimpl* form);
+    AST* visit(ASTForm_All0* form);
+    AST* visit(ASTForm_All1* form);
+    AST* visit(ASTForm_All2* form);
+};
+
+#endif //WSKS_LOCALREWRITER_H
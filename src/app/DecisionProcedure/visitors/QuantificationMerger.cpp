@@ -5,13 +5,16 @@
 #include "QuantificationMerger.h"
 #include "../../Frontend/ast.h"
 #include "../../Frontend/ident.h"
+#include "../utils/VarSet.h"
 
 template<class ForallClass>
 AST* mergeUniversal(ForallClass* form) {
     if(form->f->kind == aAll1 || form->f->kind == aAll2) {
         ASTForm_uvf* innerQuantifier = reinterpret_cast<ASTForm_uvf*>(form->f);
         form->f = innerQuantifier->f;
-        form->vl = ident_union(form->vl, innerQuantifier->vl);
+        VarSet merged(form->vl);
+        merged.Insert(innerQuantifier->vl);
+        form->vl = merged.ToIdentList();
 
         innerQuantifier->detach();
         delete innerQuantifier;
@@ -33,7 +36,9 @@ AST* mergeExistential(ExistClass* form) {
         ASTForm_uvf* innerQuantifier = reinterpret_cast<ASTForm_uvf*>(form->f);
         form->f = innerQuantifier->f;
         IdentList* oldList = form->vl;
-        form->vl = ident_union(form->vl, innerQuantifier->vl);
+        VarSet merged(form->vl);
+        merged.Insert(innerQuantifier->vl);
+        form->vl = merged.ToIdentList();
 
         // Clean up
         delete oldList;
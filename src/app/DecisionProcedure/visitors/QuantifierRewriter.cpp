@@ -0,0 +1,86 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Fused restriction and merging of quantifiers: restricts the quantified
+ *    variables to second order by SecondOrderRestricter and merges the
+ *    resulting chains of quantifiers by QuantificationMerger in one
+ *    bottom-up traversal.
+ *
+ *****************************************************************************/
+
+#include "QuantifierRewriter.h"
+
+/**
+ * Merges the quantifiers in the chain created by restriction of single quantifier. The chain consists of
+ * quantifiers and binary connectives with the restrictions on left and the rest of the chain on the right,
+ * ending with the already rewritten @p body, so we only walk the spine and merge bottom-up.
+ *
+ * @param[in] form:     the node of the chain
+ * @param[in] body:     the original (already rewritten) body of restricted quantifier
+ * @return:             merged chain
+ */
+ASTForm* QuantifierRewriter::_MergeChain(ASTForm* form, ASTForm* body) {
+    if(form == body) {
+        return form;
+    }
+
+    switch(form->kind) {
+        case aEx1:
+        case aEx2:
+        case aAll1:
+        case aAll2: {
+            ASTForm_q* quantifier = static_cast<ASTForm_q*>(form);
+            quantifier->f = this->_MergeChain(quantifier->f, body);
+            switch(form->kind) {
+                case aEx1:
+                    return static_cast<ASTForm*>(this->_merger.visit(static_cast<ASTForm_Ex1*>(form)));
+                case aEx2:
+                    return static_cast<ASTForm*>(this->_merger.visit(static_cast<ASTForm_Ex2*>(form)));
+                case aAll1:
+                    return static_cast<ASTForm*>(this->_merger.visit(static_cast<ASTForm_All1*>(form)));
+                default:
+                    return static_cast<ASTForm*>(this->_merger.visit(static_cast<ASTForm_All2*>(form)));
+            }
+        }
+        case aAnd:
+        case aImpl: {
+            // Restrictions are freshly cloned, so they were not visited by the merger yet
+            ASTForm_ff* binop = static_cast<ASTForm_ff*>(form);
+            binop->f1 = static_cast<ASTForm*>(binop->f1->accept(this->_merger));
+            binop->f2 = this->_MergeChain(binop->f2, body);
+            return form;
+        }
+        default:
+            return static_cast<ASTForm*>(form->accept(this->_merger));
+    }
+}
+
+template<class Quantifier>
+AST* QuantifierRewriter::_RestrictAndMerge(Quantifier* form) {
+    ASTForm* body = form->f;
+    ASTForm* restricted = static_cast<ASTForm*>(this->_restricter.visit(form));
+    return this->_MergeChain(restricted, body);
+}
+
+AST* QuantifierRewriter::visit(ASTForm_Ex1* form) {
+    return this->_RestrictAndMerge<ASTForm_Ex1>(form);
+}
+
+AST* QuantifierRewriter::visit(ASTForm_Ex2* form) {
+    return this->_RestrictAndMerge<ASTForm_Ex2>(form);
+}
+
+AST* QuantifierRewriter::visit(ASTForm_All1* form) {
+    return this->_RestrictAndMerge<ASTForm_All1>(form);
+}
+
+AST* QuantifierRewriter::visit(ASTForm_All2* form) {
+    return this->_RestrictAndMerge<ASTForm_All2>(form);
+}
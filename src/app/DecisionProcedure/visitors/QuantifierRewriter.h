@@ -0,0 +1,44 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Fused restriction and merging of quantifiers: restricts the quantified
+ *    variables to second order by SecondOrderRestricter and merges the
+ *    resulting chains of quantifiers by QuantificationMerger in one
+ *    bottom-up traversal.
+ *
+ *****************************************************************************/
+
+#ifndef WSKS_QUANTIFIERREWRITER_H
+#define WSKS_QUANTIFIERREWRITER_H
+
+#include "../../Frontend/ast.h"
+#include "../../Frontend/ast_visitor.h"
+#include "SecondOrderRestricter.h"
+#include "QuantificationMerger.h"
+
+class QuantifierRewriter : public TransformerVisitor {
+private:
+    SecondOrderRestricter _restricter;
+    QuantificationMerger _merger;
+
+    ASTForm* _MergeChain(ASTForm* form, ASTForm* body);
+    template<class Quantifier>
+    AST* _RestrictAndMerge(Quantifier* form);
+
+public:
+    QuantifierRewriter() : TransformerVisitor(Traverse::PostOrder) {}
+
+    AST* visit(ASTForm_Ex1* form);
+    AST* visit(ASTForm_Ex2* form);
+    AST* visit(ASTForm_All1* form);
+    AST* visit(ASTForm_All2* form);
+};
+
+#endif //WSKS_QUANTIFIERREWRITER_H
@@ -21,10 +21,12 @@
 #include <iostream>
 #include <stdlib.h>
 #include <string.h>
+#include <boost/functional/hash.hpp>
 #include "ast.h"
 #include "symboltable.h"
 #include "predlib.h"
 #include "lib.h"
+#include "env.h"
 #include "../DecisionProcedure/containers/VarToTrackMap.hh"
 
 using std::cout;
@@ -418,7 +420,7 @@ ASTTerm1_Root::makeCode(SubstCode *subst)
     pos.printsource();
     cout << "\n'root' applied onto multiple universes\n" 
 	 << "Execution aborted\n";
-    exit(-1);
+    abortExecution("'root' applied onto multiple universes");
   }
   univ = d2->get(0);
   if (symbolTable.lookupType(univ)!=Univname && symbolTable.lookupType(univ)!=Statespacename) {
@@ -426,7 +428,7 @@ ASTTerm1_Root::makeCode(SubstCode *subst)
     pos.printsource();
     cout << "\nIllegal argument to 'root'\n"
 	 << "Execution aborted\n";
-    exit(-1);
+    abortExecution("Illegal argument to 'root'");
   }
   delete d2;
 
@@ -452,7 +454,7 @@ ASTTerm1_Int::makeCode(SubstCode *)
     cout << "Error:";
     pos.printsource();
     cout << "\nNegative integer encountered\n" << "Execution aborted\n";
-    exit(-1);
+    abortExecution("Negative integer encountered");
   }
 
   Ident var = symbolTable.insertFresh(Varname1);
@@ -1814,7 +1816,7 @@ ASTForm_Import::makeCode(SubstCode *subst)
 	pos.printsource();
 	cout << "\nIllegal to substitute Boolean expression through macro "
 	     << "at import\n" << "Execution aborted\n";
-	exit(-1); 
+	abortExecution("Illegal to substitute Boolean expression through macro at import"); 
 	// (can't do that since macro arguments are code-generated
 	// before macro expansion)
       case sIdent:
@@ -1958,145 +1960,184 @@ project(VarCode vc, ASTTermCode *t, Pos p)
 
 /* Structural compare */
 
+/**
+ * Compares the variables modulo the @p renaming. Without renaming the variables have to be the same, otherwise
+ * the first occurrence of @p lhs binds it to @p rhs. The special variable for all positions is never renamed.
+ *
+ * @param[in] lhs:          variable of the left formula
+ * @param[in] rhs:          variable of the right formula
+ * @param[in] renaming:     renaming of left variables to right ones constructed so far
+ * @return:                 true if variables correspond to each other
+ */
+inline bool compare_vars(Ident lhs, Ident rhs, VarRenaming* renaming) {
+    if(renaming == nullptr || lhs == allPosVar || rhs == allPosVar) {
+        return lhs == rhs;
+    }
+    auto it = renaming->find(lhs);
+    if(it == renaming->end()) {
+        renaming->insert(std::make_pair(lhs, rhs));
+        return true;
+    } else {
+        return it->second == static_cast<unsigned int>(rhs);
+    }
+}
+
+/**
+ * Compares the lists of quantified variables modulo the @p renaming
+ */
+inline bool compare_var_lists(IdentList* lhs, IdentList* rhs, VarRenaming* renaming) {
+    if(lhs == nullptr || rhs == nullptr) {
+        return lhs == rhs;
+    } else if(lhs->size() != rhs->size()) {
+        return false;
+    }
+    for(auto lit = lhs->begin(), rit = rhs->begin(); lit != lhs->end(); ++lit, ++rit) {
+        if(!compare_vars(*lit, *rit, renaming)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 template<class Binop>
-bool binary_structural_compare(ASTForm* lhs, ASTForm* rhs) {
+bool binary_structural_compare(ASTForm* lhs, ASTForm* rhs, VarRenaming* renaming) {
     if(lhs->kind != rhs->kind) {
         return false;
     } else {
         Binop* lhs_binop = reinterpret_cast<Binop*>(lhs);
         Binop* rhs_binop = reinterpret_cast<Binop*>(rhs);
-        return lhs_binop->f1->StructuralCompare(rhs_binop->f1) && lhs_binop->f2->StructuralCompare(rhs_binop->f2);
+        return lhs_binop->f1->StructuralCompare(rhs_binop->f1, renaming) && lhs_binop->f2->StructuralCompare(rhs_binop->f2, renaming);
     }
 }
 
 template<class Unop>
-bool unary_structural_compare(ASTForm* lhs, ASTForm* rhs) {
+bool unary_structural_compare(ASTForm* lhs, ASTForm* rhs, VarRenaming* renaming) {
     if(rhs->kind != lhs->kind) {
         return false;
     } else {
         Unop* lhs_un = reinterpret_cast<Unop*>(lhs);
         Unop* rhs_un = reinterpret_cast<Unop*>(rhs);
-        return lhs_un->f->StructuralCompare(rhs_un->f);
+        return lhs_un->f->StructuralCompare(rhs_un->f, renaming);
     }
 }
 
-bool ASTTerm1_n::StructuralCompare(AST* form) {
+bool ASTTerm1_n::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     return this->kind == form->kind && this->n == reinterpret_cast<ASTTerm1_n*>(form)->n;
 }
 
-bool ASTTerm1_T::StructuralCompare(AST* form) {
+bool ASTTerm1_T::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
-    return this->kind == form->kind && this->T->StructuralCompare(reinterpret_cast<ASTTerm1_T*>(form)->T);
+    return this->kind == form->kind && this->T->StructuralCompare(reinterpret_cast<ASTTerm1_T*>(form)->T, renaming);
 }
 
-bool ASTTerm1_t::StructuralCompare(AST* form) {
+bool ASTTerm1_t::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
-    return this->kind == form->kind && this->t->StructuralCompare(reinterpret_cast<ASTTerm1_t*>(form)->t);
+    return this->kind == form->kind && this->t->StructuralCompare(reinterpret_cast<ASTTerm1_t*>(form)->t, renaming);
 }
 
-bool ASTTerm1_tn::StructuralCompare(AST* form) {
+bool ASTTerm1_tn::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTTerm1_tn* tn = reinterpret_cast<ASTTerm1_tn*>(form);
-        return this->t->StructuralCompare(tn->t) && this->n == tn->n;
+        return this->t->StructuralCompare(tn->t, renaming) && this->n == tn->n;
     }
 }
 
-bool ASTTerm1_tnt::StructuralCompare(AST* form) {
+bool ASTTerm1_tnt::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTTerm1_tnt* tnt = reinterpret_cast<ASTTerm1_tnt*>(form);
-        return this->t1->StructuralCompare(tnt->t1) && this->n == tnt->n && this->t2->StructuralCompare(tnt->t2);
+        return this->t1->StructuralCompare(tnt->t1, renaming) && this->n == tnt->n && this->t2->StructuralCompare(tnt->t2, renaming);
     }
 }
 
-bool ASTTerm2_TT::StructuralCompare(AST* form) {
+bool ASTTerm2_TT::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTTerm2_TT* TT = reinterpret_cast<ASTTerm2_TT*>(form);
-        return this->T1->StructuralCompare(TT->T1) && this->T2->StructuralCompare(TT->T2);
+        return this->T1->StructuralCompare(TT->T1, renaming) && this->T2->StructuralCompare(TT->T2, renaming);
     }
 }
 
-bool ASTTerm2_Tn::StructuralCompare(AST* form) {
+bool ASTTerm2_Tn::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTTerm2_Tn* Tn = reinterpret_cast<ASTTerm2_Tn*>(form);
-        return this->T->StructuralCompare(Tn->T) && this->n == Tn->n;
+        return this->T->StructuralCompare(Tn->T, renaming) && this->n == Tn->n;
     }
 }
 
-bool ASTForm_tt::StructuralCompare(AST* form) {
+bool ASTForm_tt::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTForm_tt* tt = reinterpret_cast<ASTForm_tt*>(form);
-        return this->t1->StructuralCompare(tt->t1) && this->t2->StructuralCompare(tt->t2);
+        return this->t1->StructuralCompare(tt->t1, renaming) && this->t2->StructuralCompare(tt->t2, renaming);
     }
 }
 
-bool ASTForm_tT::StructuralCompare(AST* form) {
+bool ASTForm_tT::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTForm_tT* tT = reinterpret_cast<ASTForm_tT*>(form);
-        return this->t1->StructuralCompare(tT->t1) && this->T2->StructuralCompare(tT->T2);
+        return this->t1->StructuralCompare(tT->t1, renaming) && this->T2->StructuralCompare(tT->T2, renaming);
     }
 }
 
-bool ASTForm_T::StructuralCompare(AST* form) {
+bool ASTForm_T::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
-    return this->kind == form->kind && this->T->StructuralCompare(reinterpret_cast<ASTForm_T*>(form)->T);
+    return this->kind == form->kind && this->T->StructuralCompare(reinterpret_cast<ASTForm_T*>(form)->T, renaming);
 }
 
-bool ASTForm_TT::StructuralCompare(AST* form) {
+bool ASTForm_TT::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTForm_TT* TT_form = reinterpret_cast<ASTForm_TT*>(form);
-        return this->T1->StructuralCompare(TT_form->T1) && this->T2->StructuralCompare(TT_form->T2);
+        return this->T1->StructuralCompare(TT_form->T1, renaming) && this->T2->StructuralCompare(TT_form->T2, renaming);
     }
 }
 
-bool ASTForm_nt::StructuralCompare(AST* form) {
+bool ASTForm_nt::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTForm_nt* nt = reinterpret_cast<ASTForm_nt*>(form);
-        return this->n == nt->n && this->t->StructuralCompare(nt->t);
+        return this->n == nt->n && this->t->StructuralCompare(nt->t, renaming);
     }
 
 }
 
-bool ASTForm_nT::StructuralCompare(AST* form) {
+bool ASTForm_nT::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTForm_nT* nT = reinterpret_cast<ASTForm_nT*>(form);
-        return this->n == nT->n && this->T->StructuralCompare(nT->T);
+        return this->n == nT->n && this->T->StructuralCompare(nT->T, renaming);
     }
 }
 
-bool ASTForm_f::StructuralCompare(AST* form) {
+bool ASTForm_f::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
-    return this->kind == form->kind && this->f->StructuralCompare(reinterpret_cast<ASTForm_f*>(form)->f);
+    return this->kind == form->kind && this->f->StructuralCompare(reinterpret_cast<ASTForm_f*>(form)->f, renaming);
 }
 
-bool ASTForm_ff::StructuralCompare(AST* form) {
+bool ASTForm_ff::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
@@ -2104,48 +2145,316 @@ bool ASTForm_ff::StructuralCompare(AST* form) {
         return false;
     } else {
         ASTForm_ff* ff = reinterpret_cast<ASTForm_ff*>(form);
-        return this->f1->StructuralCompare(ff->f1) && this->f2->StructuralCompare(ff->f2);
+        return this->f1->StructuralCompare(ff->f1, renaming) && this->f2->StructuralCompare(ff->f2, renaming);
     }
 }
 
-bool ASTForm_q::StructuralCompare(AST* form) {
+bool ASTForm_q::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     if(this->kind != form->kind) {
         return false;
     } else {
         ASTForm_q* q = reinterpret_cast<ASTForm_q*>(form);
         //Fixme: There should be correlation between sizes of quantified stuff
-        return this->f->StructuralCompare(q->f);
+        return this->f->StructuralCompare(q->f, renaming);
     }
 }
 
-bool ASTTerm1_Var1::StructuralCompare(AST* form) {
+bool ASTForm_vf::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
-    // Fixme: There should be mapping
-    return this->kind == form->kind;
+    if(this->kind != form->kind) {
+        return false;
+    } else {
+        ASTForm_vf* vf = reinterpret_cast<ASTForm_vf*>(form);
+        return compare_var_lists(this->vl, vf->vl, renaming) && this->f->StructuralCompare(vf->f, renaming);
+    }
 }
 
-bool ASTTerm2_Var2::StructuralCompare(AST* form) {
+bool ASTForm_uvf::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
-    // Fixme: There should be mapping
-    return this->kind == form->kind;
+    if(this->kind != form->kind) {
+        return false;
+    } else {
+        ASTForm_uvf* uvf = reinterpret_cast<ASTForm_uvf*>(form);
+        return compare_var_lists(this->vl, uvf->vl, renaming) && this->f->StructuralCompare(uvf->f, renaming);
+    }
+}
+
+bool ASTTerm1_Var1::StructuralCompare(AST* form, VarRenaming* renaming) {
+    assert(form != nullptr);
+    return this->kind == form->kind && compare_vars(this->n, reinterpret_cast<ASTTerm1_Var1*>(form)->n, renaming);
 }
 
-bool ASTForm_FirstOrder::StructuralCompare(AST* form) {
+bool ASTTerm2_Var2::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
-    return this->kind == form->kind && this->t->StructuralCompare(reinterpret_cast<ASTForm_FirstOrder*>(form)->t);
+    return this->kind == form->kind && compare_vars(this->n, reinterpret_cast<ASTTerm2_Var2*>(form)->n, renaming);
 }
 
-bool ASTForm_Not::StructuralCompare(AST* form) {
+bool ASTForm_Var0::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
-    return this->kind == form->kind && this->f->StructuralCompare(reinterpret_cast<ASTForm_Not*>(form)->f);
+    return this->kind == form->kind && compare_vars(this->n, reinterpret_cast<ASTForm_Var0*>(form)->n, renaming);
 }
 
-bool ASTTerm2_Empty::StructuralCompare(AST* form) {
+bool ASTForm_FirstOrder::StructuralCompare(AST* form, VarRenaming* renaming) {
+    assert(form != nullptr);
+    return this->kind == form->kind && this->t->StructuralCompare(reinterpret_cast<ASTForm_FirstOrder*>(form)->t, renaming);
+}
+
+bool ASTForm_Not::StructuralCompare(AST* form, VarRenaming* renaming) {
+    assert(form != nullptr);
+    return this->kind == form->kind && this->f->StructuralCompare(reinterpret_cast<ASTForm_Not*>(form)->f, renaming);
+}
+
+bool ASTTerm2_Empty::StructuralCompare(AST* form, VarRenaming* renaming) {
     assert(form != nullptr);
     return this->kind == form->kind;
 }
 
+/* Structural hashing */
+
+/**
+ * Hashes the variable modulo the @p renaming, i.e. by the order of its first occurrence
+ *
+ * @param[in] var:          hashed variable
+ * @param[in] renaming:     canonical renaming of variables constructed so far
+ * @return:                 hash of the variable
+ */
+inline size_t hash_var(Ident var, VarRenaming* renaming) {
+    if(renaming == nullptr || var == allPosVar) {
+        return static_cast<size_t>(var);
+    }
+    auto it = renaming->find(var);
+    if(it == renaming->end()) {
+        it = renaming->insert(std::make_pair(var, renaming->size())).first;
+    }
+    return it->second;
+}
+
+/**
+ * Computes the hash of the node together with its children; the formula nodes
+ * moreover refresh their size, so the hash doubles as the node counter. If the
+ * @p renaming is given, the hash is computed modulo renaming of variables.
+ */
+size_t ASTTerm1_n::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->n);
+    return seed;
+}
+
+size_t ASTTerm1_T::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->T->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTTerm1_t::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->t->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTTerm1_tn::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->t->StructuralHash(renaming));
+    boost::hash_combine(seed, this->n);
+    return seed;
+}
+
+size_t ASTTerm1_tnt::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->t1->StructuralHash(renaming));
+    boost::hash_combine(seed, this->n);
+    boost::hash_combine(seed, this->t2->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTTerm2_TT::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->T1->StructuralHash(renaming));
+    boost::hash_combine(seed, this->T2->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTTerm2_Tn::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->T->StructuralHash(renaming));
+    boost::hash_combine(seed, this->n);
+    return seed;
+}
+
+size_t ASTTerm1_Var1::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, hash_var(this->n, renaming));
+    return seed;
+}
+
+size_t ASTTerm2_Var2::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, hash_var(this->n, renaming));
+    return seed;
+}
+
+size_t ASTForm_tT::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->t1->StructuralHash(renaming));
+    boost::hash_combine(seed, this->T2->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTForm_T::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->T->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTForm_TT::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->T1->StructuralHash(renaming));
+    boost::hash_combine(seed, this->T2->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTForm_tt::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->t1->StructuralHash(renaming));
+    boost::hash_combine(seed, this->t2->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTForm_nt::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->n);
+    boost::hash_combine(seed, this->t->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTForm_nT::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->n);
+    boost::hash_combine(seed, this->T->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTForm_Var0::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, hash_var(this->n, renaming));
+    return seed;
+}
+
+size_t ASTForm_FirstOrder::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->t->StructuralHash(renaming));
+    return seed;
+}
+
+size_t ASTForm_f::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->f->StructuralHash(renaming));
+    this->size = this->f->size + 1;
+    return seed;
+}
+
+size_t ASTForm_Not::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->f->StructuralHash(renaming));
+    this->size = this->f->size + 1;
+    return seed;
+}
+
+size_t ASTForm_ff::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    boost::hash_combine(seed, this->f1->StructuralHash(renaming));
+    boost::hash_combine(seed, this->f2->StructuralHash(renaming));
+    this->size = this->f1->size + this->f2->size + 1;
+    return seed;
+}
+
+size_t ASTForm_vf::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    for(auto it = this->vl->begin(); it != this->vl->end(); ++it) {
+        boost::hash_combine(seed, hash_var(*it, renaming));
+    }
+    boost::hash_combine(seed, this->f->StructuralHash(renaming));
+    this->size = this->f->size + 1;
+    return seed;
+}
+
+size_t ASTForm_uvf::StructuralHash(VarRenaming* renaming) {
+    size_t seed = static_cast<size_t>(this->kind);
+    if(this->vl != nullptr) {
+        for (auto it = this->vl->begin(); it != this->vl->end(); ++it) {
+            boost::hash_combine(seed, hash_var(*it, renaming));
+        }
+    }
+    boost::hash_combine(seed, this->f->StructuralHash(renaming));
+    this->size = this->f->size + 1;
+    return seed;
+}
+
+/**
+ * Returns the hash of the formula modulo renaming of variables used for sharing of the structurally same
+ * subformulae. Atomic formulae are hashed modulo their own canonical renaming, while the inner nodes combine the
+ * hashes of their children, so the hash is computed only once for each node. The sharing of variables between
+ * children is not part of the hash, but is checked by the StructuralCompare.
+ *
+ * @return: hash of the formula modulo renaming
+ */
+size_t ASTForm::DagHash() {
+    // Passes rewrite the formula in place, so the hash is recomputed after each of them
+    if(this->dag_hash != 0 && this->dagHashEpoch == ASTForm::varsEpoch) {
+        return this->dag_hash;
+    }
+
+    size_t seed = static_cast<size_t>(this->kind);
+    switch(this->kind) {
+        case aAnd:
+        case aOr:
+        case aImpl:
+        case aBiimpl:
+        case aIdLeft: {
+            ASTForm_ff* ff = static_cast<ASTForm_ff*>(this);
+            boost::hash_combine(seed, ff->f1->DagHash());
+            boost::hash_combine(seed, ff->f2->DagHash());
+            this->size = ff->f1->size + ff->f2->size + 1;
+            break;
+        }
+        case aNot: {
+            ASTForm_Not* notf = static_cast<ASTForm_Not*>(this);
+            boost::hash_combine(seed, notf->f->DagHash());
+            this->size = notf->f->size + 1;
+            break;
+        }
+        case aEx0:
+        case aAll0: {
+            ASTForm_vf* vf = static_cast<ASTForm_vf*>(this);
+            boost::hash_combine(seed, vf->vl->size());
+            boost::hash_combine(seed, vf->f->DagHash());
+            this->size = vf->f->size + 1;
+            break;
+        }
+        case aEx1:
+        case aEx2:
+        case aAll1:
+        case aAll2: {
+            ASTForm_uvf* uvf = static_cast<ASTForm_uvf*>(this);
+            boost::hash_combine(seed, uvf->vl == nullptr ? 0 : uvf->vl->size());
+            boost::hash_combine(seed, uvf->f->DagHash());
+            this->size = uvf->f->size + 1;
+            break;
+        }
+        default: {
+            VarRenaming renaming;
+            seed = this->StructuralHash(&renaming);
+            break;
+        }
+    }
+
+    // Zero is reserved for the not yet computed hash
+    this->dag_hash = (seed == 0 ? 1 : seed);
+    this->dagHashEpoch = ASTForm::varsEpoch;
+    return this->dag_hash;
+}
+
 // Remapping
 void ASTTerm1_n::ConstructMapping(AST* form, std::map<unsigned int, unsigned int>& map) {
     assert(this->kind == form->kind);
@@ -2240,6 +2549,31 @@ void ASTForm_q::ConstructMapping(AST* form, std::map<unsigned int, unsigned int>
 }
 
 extern VarToTrackMap varMap;
+/**
+ * Maps the tracks of the quantified variables @p from to the tracks of @p to (with the same positions in lists)
+ */
+static void constructQuantifierMapping(IdentList* from, IdentList* to, std::map<unsigned int, unsigned int>& map) {
+    if(from == nullptr || to == nullptr) {
+        assert(from == to);
+        return;
+    }
+    assert(from->size() == to->size());
+    for(auto f = from->begin(), t = to->begin(); f != from->end() && t != to->end(); ++f, ++t) {
+        map[varMap[*f]] = varMap[*t];
+    }
+}
+
+void ASTForm_vf::ConstructMapping(AST* form, std::map<unsigned int, unsigned int>& map) {
+    assert(this->kind == form->kind);
+    constructQuantifierMapping(this->vl, reinterpret_cast<ASTForm_vf*>(form)->vl, map);
+    this->f->ConstructMapping(reinterpret_cast<ASTForm_vf*>(form)->f, map);
+}
+
+void ASTForm_uvf::ConstructMapping(AST* form, std::map<unsigned int, unsigned int>& map) {
+    assert(this->kind == form->kind);
+    constructQuantifierMapping(this->vl, reinterpret_cast<ASTForm_uvf*>(form)->vl, map);
+    this->f->ConstructMapping(reinterpret_cast<ASTForm_uvf*>(form)->f, map);
+}
 void ASTTerm1_Var1::ConstructMapping(AST* form, std::map<unsigned int, unsigned int>& map) {
     assert(this->kind == form->kind);
     map[varMap[this->n]] = varMap[reinterpret_cast<ASTTerm1_Var1*>(form)->n];
@@ -26,6 +26,7 @@
 #include "printline.h"
 #include <vata/bdd_bu_tree_aut.hh>
 #include <cstring>
+#include <map>
 
 using Automaton = VATA::BDDBottomUpTreeAut;
 
@@ -93,6 +94,9 @@ enum ASTKind {
 
 enum ASTOrder {oTerm1, oTerm2, oForm, oUniv};
 
+// Renaming of variables between two structurally same formulae
+using VarRenaming = std::map<unsigned int, unsigned int>;
+
 class ASTList;
 class VoidVisitor;
 class TransformerVisitor;
@@ -110,13 +114,15 @@ public:
 	virtual void detach() {}
 	virtual std::string ToString(bool no_utf = false) { return std::string("");}
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&) { this->dump(); std::cout << "\n"; assert(false && "Called ConstructMapping() base function\n");};
-	virtual bool StructuralCompare(AST* f) {return f->kind == this->kind;}
+	virtual bool StructuralCompare(AST* f, VarRenaming* renaming = nullptr) {return f->kind == this->kind;}
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr) { return static_cast<size_t>(this->kind); }
 
 	size_t tag = 1;
 	size_t fixpoint_number = 0;
 	size_t height = 1;
 	size_t dag_height = 1;
 	size_t size = 1;
+	size_t dag_hash = 0;
   ASTOrder order;
   ASTKind kind;
   Pos pos;
@@ -169,11 +175,23 @@ class ASTForm: public AST {
 public:
   ASTForm(ASTKind kind, Pos p) :
 		  AST(oForm, kind, p) {}
+  ASTForm(const ASTForm& form) :
+		  AST(form), sfa(form.sfa) {}  // clones do not share the memoized variables
+  ~ASTForm() { delete cachedFree; delete cachedBound; }
 
   VISITABLE();
 
 	SymbolicAutomaton* sfa = nullptr;
 
+	// Memoized free and bound variables of the subformula, valid while cachedEpoch == varsEpoch
+	IdentList* cachedFree = nullptr;
+	IdentList* cachedBound = nullptr;
+	size_t cachedEpoch = 0;
+	size_t dagHashEpoch = 0;		// dag_hash is valid while dagHashEpoch == varsEpoch
+	static size_t varsEpoch;
+	static void InvalidateVarsCache() { ++ASTForm::varsEpoch; }
+	void freeVarsCached(IdentList*, IdentList*);
+
   virtual VarCode makeCode(SubstCode *subst = NULL) = 0;
   void dump() = 0;
 
@@ -191,6 +209,7 @@ public:
   virtual void toUnaryAutomaton(Automaton &aut, bool doComplement) { std::cerr << "Missing automaton for this formula\n"; this->dump();}
   virtual void toBinaryAutomaton(Automaton &aut, bool doComplement) { std::cerr << "Missing automaton for this formula\n"; this->dump(); }
 	virtual SymbolicAutomaton* toSymbolicAutomaton(bool doComplement);
+	size_t DagHash();
 	virtual SymbolicAutomaton* _toSymbolicAutomatonCore(bool doComplement);
 };
 
@@ -255,7 +274,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   int n;
 };
@@ -268,7 +288,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
 
@@ -283,7 +304,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
 
@@ -298,7 +320,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTTerm1* unfoldMacro(IdentList*, ASTList*);
@@ -315,7 +338,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
 
@@ -332,7 +356,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTTerm2* unfoldMacro(IdentList*, ASTList*);
@@ -349,7 +374,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTTerm2 *unfoldMacro(IdentList*, ASTList*);
@@ -366,7 +392,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTForm* unfoldMacro(IdentList*, ASTList*);
@@ -383,7 +410,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTForm *unfoldMacro(IdentList*, ASTList*);
@@ -399,7 +427,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTForm* unfoldMacro(IdentList*, ASTList*);
@@ -416,7 +445,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTForm* unfoldMacro(IdentList*, ASTList*);
@@ -433,7 +463,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
 
@@ -449,7 +480,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
 
@@ -465,7 +497,8 @@ public:
 
   VISITABLE();;
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTForm* unfoldMacro(IdentList*, ASTList*);
@@ -481,7 +514,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTForm* unfoldMacro(IdentList*, ASTList*);
@@ -496,7 +530,7 @@ public:
 		  ASTForm(kind, p), f(ff) {}
   ~ASTForm_q() {delete f;}
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
 
   ASTForm *f;
 };
@@ -508,6 +542,9 @@ public:
   ~ASTForm_vf() {delete vl;}
 
   VISITABLE();
+	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTForm* unfoldMacro(IdentList*, ASTList*);
@@ -527,6 +564,9 @@ public:
   }
 
   VISITABLE();
+	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTForm* unfoldMacro(IdentList*, ASTList*);
@@ -544,7 +584,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTTermCode *makeCode(SubstCode *subst = NULL);
@@ -705,7 +746,8 @@ public:
 
   VISITABLE();
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   ASTTermCode *makeCode(SubstCode *subst = NULL);
@@ -778,7 +820,7 @@ public:
   ASTTermCode *makeCode(SubstCode *subst = NULL);
 	virtual ASTTerm2* clone() { return new ASTTerm2_Empty(Pos()); }
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
   void dump();
 	virtual std::string ToString(bool no_utf = false);
 };
@@ -919,6 +961,8 @@ public:
 		  ASTForm(aVar0, p), n(nn) {}
 
   VISITABLE();
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
 
   void freeVars(IdentList*, IdentList*);
   VarCode makeCode(SubstCode *subst = NULL);
@@ -1054,7 +1098,8 @@ public:
   void dump();
 	virtual std::string ToString(bool no_utf = false);
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
   ASTForm* clone() { return new ASTForm_FirstOrder(this->t->clone(), this->pos); }
 
   // Conversion of AST representation of formula to Automaton
@@ -1277,7 +1322,8 @@ public:
 	virtual std::string ToString(bool no_utf = false);
   ASTForm* clone() { return new ASTForm_Not(this->f->clone(), this->pos); }
   ASTForm* unfoldMacro(IdentList*, ASTList*);
-	virtual bool StructuralCompare(AST*);
+	virtual bool StructuralCompare(AST*, VarRenaming* renaming = nullptr);
+	virtual size_t StructuralHash(VarRenaming* renaming = nullptr);
 	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
 
   void toUnaryAutomaton(Automaton &aut, bool doComplement);
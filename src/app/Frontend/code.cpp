@@ -19,6 +19,7 @@
  */
 
 #include <iostream>
+#include <sstream>
 #include <string.h>
 #include "codetable.h"
 #include "offsets.h"
@@ -26,6 +27,7 @@
 #include "symboltable.h"
 #include "env.h"
 #include "lib.h"
+#include "../DecisionProcedure/utils/ParallelTranslation.h"
 
 using std::cout;
 
@@ -147,6 +149,12 @@ VarCode::remove()
   if (code) {
     if (vars != &code->vars)
       delete vars;
+    if (codeTable->keepsCodes()) {
+      // node stays in the table until it is deleted, the link is kept, so
+      // the parent is still found by the equivalent nodes of next formulae
+      vars = NULL;
+      return;
+    }
     code->remove();
     code = NULL;
   }
@@ -242,7 +250,9 @@ Code::error(String str)
   cout << "\nError:";
   pos.printsource();
   cout << "\n" << str << "\n" << "Execution aborted\n";  
-  exit(-1);
+  std::ostringstream reason;
+  reason << str;
+  abortExecution(reason.str());
 }
 
 ////////// Code_n /////////////////////////////////////////////////////////////
@@ -449,12 +459,16 @@ Code_cc::makeDFA()
 {
   /* #warning NEW: heuristic choice through DAG - 1-15% lower max-aut. */
   if (vc1.code->refs==1 || (vc2.code->refs>1 && vc1.code->depth<=vc2.code->depth)) {
+    if (Gaston::TranslateConcurrently(vc1, a1, vc2, a2))
+      return;
     a1 = vc1.DFATranslate();
     vc1.remove();
     a2 = vc2.DFATranslate();
     vc2.remove();
   }
   else {
+    if (Gaston::TranslateConcurrently(vc2, a2, vc1, a1))
+      return;
     a2 = vc2.DFATranslate();
     vc2.remove();
     a1 = vc1.DFATranslate();
@@ -35,6 +35,25 @@ using std::cout;
 
 extern Options options;
 
+CodeTable::~CodeTable()
+{
+  if (!keep)
+    return;
+
+  // nodes are linked only within the table, so they are deleted at once
+  // (removing of the references by the nodes is disabled by keepsCodes())
+  for (unsigned b = 0; b < CODE_TABLE_SIZE; b++) {
+    while (!table[b].empty()) {
+      Code *c = table[b].pop_back();
+      if (c->dfa)
+	dfaFree(c->dfa);
+      if (c->gta)
+	gtaFree(c->gta);
+      delete c;
+    }
+  }
+}
+
 VarCode
 CodeTable::insert(Code *c)
 {
@@ -53,6 +72,8 @@ CodeTable::insert(Code *c)
 
   table[hash].push_back(c);
   c->bucket = hash;
+  if (keep)
+    c->refs++; // the table itself holds the node, so its DFA is always kept
 
   // update statistics
   stat_misses++;
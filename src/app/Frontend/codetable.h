@@ -46,9 +46,14 @@ class CodeTable {
 **/
 
 public:
-  CodeTable() 
+  CodeTable(bool keep = false) : keep(keep)
   {stat_hits = stat_misses = nodes = makes = prev
      = red_proj = red_prod = red_other = num_prod = num_proj = num_other = 0;}
+  ~CodeTable();
+
+  // persistent table keeps all nodes (and their DFAs) until it is deleted,
+  // so common sub-DAGs of the subsequent formulae are translated only once
+  bool keepsCodes() const {return keep;}
 
   VarCode insert(Code*); 
   bool    exists(Code&);
@@ -78,6 +83,9 @@ public:
   int num_prod, num_proj, num_other; // number of operations
 
   int makes, prev; // number of automata constructed
+
+private:
+  bool keep;
 };
 
 #endif
@@ -21,6 +21,9 @@
 #ifndef __ENV_H
 #define __ENV_H
 
+#include <stdexcept>
+#include <string>
+
 enum Mode {LINEAR, TREE};
 enum ReorderMode {NO, RANDOM, HEURISTIC};
 enum Method {FORWARD, BACKWARD, SYMBOLIC};
@@ -41,7 +44,7 @@ public:
     inheritedAcceptance(false), unrestrict(false),
     monaWalk(false),expandTagged(false),
     alternativeM2LStr(false), test(EVERYTHING), reorder(HEURISTIC), optimize(0),
-    useMonaDFA(false), serializeMona(false) {}
+    useMonaDFA(false), serializeMona(false), libraryMode(false) {}
 
   bool useMonaDFA;
   bool noExpnf;
@@ -75,6 +78,16 @@ public:
   ReorderMode reorder;
   unsigned optimize;
     bool serializeMona;
+  bool libraryMode; // errors of the formula are thrown instead of aborting the process
 };
 
+// Error in the formula (syntax, types, ...), thrown in the library mode
+class FrontendError : public std::runtime_error {
+public:
+  explicit FrontendError(const std::string &what) : std::runtime_error(what) {}
+};
+
+// Aborts the execution on error in the formula; the message was already printed
+[[noreturn]] void abortExecution(const std::string &reason);
+
 #endif
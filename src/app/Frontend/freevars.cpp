@@ -348,3 +348,69 @@ ASTForm_SomeType::freeVars(IdentList *free, IdentList *bound)
 {
   t->freeVars(free, bound);
 }
+
+// Memoized variables of formulae. The passes transform the formula in
+// place, hence all of the memoized sets are invalidated at once (by
+// ASTForm::InvalidateVarsCache) after each of the passes.
+
+size_t ASTForm::varsEpoch = 1;
+
+void
+ASTForm::freeVarsCached(IdentList *free, IdentList *bound)
+{
+  if (cachedEpoch != varsEpoch) {
+    IdentList *newFree = new IdentList, *newBound = new IdentList;
+    // sets of the connectives and quantifiers are composed from the
+    // memoized sets of their operands, instead of traversing them again
+    switch (kind) {
+    case aAnd:
+    case aOr:
+    case aImpl:
+    case aBiimpl:
+      ((ASTForm_ff *) this)->f1->freeVarsCached(newFree, newBound);
+      ((ASTForm_ff *) this)->f2->freeVarsCached(newFree, newBound);
+      break;
+    case aNot:
+      ((ASTForm_Not *) this)->f->freeVarsCached(newFree, newBound);
+      break;
+    case aEx0:
+    case aAll0:
+      newBound->insert(((ASTForm_vf *) this)->vl);
+      ((ASTForm_vf *) this)->f->freeVarsCached(newFree, newBound);
+      break;
+    case aEx1:
+    case aEx2:
+    case aAll1:
+    case aAll2:
+      newBound->insert(((ASTForm_uvf *) this)->vl);
+      ((ASTForm_uvf *) this)->f->freeVarsCached(newFree, newBound);
+      break;
+    default:
+      freeVars(newFree, newBound);
+      break;
+    }
+
+    delete cachedFree;
+    delete cachedBound;
+    cachedFree = newFree;
+    cachedBound = newBound;
+    cachedEpoch = varsEpoch;
+  }
+
+  if (free->empty() && bound->empty()) {
+    IdentList::iterator i;
+    for (i = cachedFree->begin(); i != cachedFree->end(); i++)
+      free->push_back(*i);
+    for (i = cachedBound->begin(); i != cachedBound->end(); i++)
+      bound->push_back(*i);
+  }
+  else {
+    // variables computed with no bound variables are free in the context
+    // of bound, unless they are bound there
+    IdentList::iterator i;
+    for (i = cachedFree->begin(); i != cachedFree->end(); i++)
+      if (!bound->exists(*i))
+        free->insert(*i);
+    bound->insert(cachedBound);
+  }
+}
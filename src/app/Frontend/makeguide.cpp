@@ -19,6 +19,7 @@
  */
 
 #include "untyped.h"
+#include "env.h"
 
 extern "C" {
 #include "mem.h"
@@ -43,7 +44,7 @@ MonaUntypedAST::makeGTAGuide()
     if (!univs || univs->empty()) {
       cout << "Error: Types declared but no universes (or trees)\n"
 	   << "Execution aborted\n";
-      exit(-1);
+      abortExecution("Types declared but no universes (or trees)");
     }
     if (univs->size() == 1) {
       // boolean and universe state space must be different
@@ -135,19 +136,19 @@ MonaUntypedAST::makeGTAGuide()
       cout << "Illegal guide and universe declarations:\n"
 	   << "Universes must have disjoint state spaces\n"
 	   << "Execution aborted\n";
-      exit(-1);
+      abortExecution("Universes must have disjoint state spaces");
     }
     if (!checkAllUsed()) {
       cout << "Illegal guide and universe declarations:\n"
 	   << "All state spaces must be reachable\n"
 	   << "Execution aborted\n";
-      exit(-1);
+      abortExecution("All state spaces must be reachable");
     }
     if (!checkAllCovered()) {
       cout << "Illegal guide and universe declarations:\n"
 	   << "Every infinite path in the guide must belong to a universe\n"
 	   << "Execution aborted\n";
-      exit(-1);
+      abortExecution("Every infinite path in the guide must belong to a universe");
     }
   }
 
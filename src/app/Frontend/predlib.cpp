@@ -57,6 +57,18 @@ void PredicateLib::cleanUp() {
 	  delete[] table;
 }
 
+void
+PredicateLib::release(Ident first) // remove predicates with Ident >= first
+{
+  int i;
+  for (i = 0; i < PREDLIB_SIZE; i++)
+    while (!table[i].empty() && table[i].top()->name >= first) {
+      PredLibEntry *p = table[i].pop_back();
+      delete p->ast;
+      delete p;
+    }
+}
+
 void 
 PredicateLib::insert(IdentList *formals, 
 		     IdentList *frees,
@@ -70,6 +70,7 @@ public:
   void          insert(IdentList *formals, IdentList *frees, IdentList *bound,
 		       ASTForm *formula, bool isMacro, int name, char *source);
   void cleanUp();
+  void release(Ident first);
   PredLibEntry *lookup(Ident);
   TestResult    testTypes(Ident name, ASTList *acts, int *no = NULL);
   PredLibEntry *first();
@@ -2530,7 +2530,7 @@ void yyerror(const char *s)
   cout << "Error in file '" << file
        << "' near line " << yylineno << ": " << s << "\n"
        << "Execution aborted\n";
-  exit(-1);
+  abortExecution(std::string("Error in file '") + file + "' near line " + std::to_string(yylineno) + ": " + s);
 }
 
 int yywrap() {
@@ -2597,7 +2597,7 @@ void loadFile(char *s) {
   cd[t] = 0;
   currentDir.push_back(cd);
 
-  if (filenumber > 0) {
+  if (currentDir.size() > 1) {
     /* save status for current file on stack */
     FileInfo f;
     f.lineno = yylineno;
@@ -2634,7 +2634,12 @@ void loadFile(char *s) {
   if (!(yyin = fopen(file, "r"))) {
     cout << "Unable to open file '" << file << "'\n"
 	 << "Execution aborted\n";
-    exit(-1);
+    abortExecution(std::string("Unable to open file '") + file + "'");
+  }
+  if (currentDir.size() == 1) {
+    /* top-level file (there may be more of them in batch mode) */
+    filenumber = source.size()-1;
+    yyrestart(yyin);
   }
   currentLine.reset(); 
   filenumber++;
@@ -2652,6 +2657,25 @@ void loadFile(char *s) {
   }
 }
 
+void abortFiles() {
+  /* close the files left open by the aborted parsing */
+  if (yyin != NULL && !currentDir.empty())
+    fclose(yyin);
+  while (loadStack.size() > 0)
+    fclose(loadStack.pop_back().handle);
+  while (!currentDir.empty())
+    delete[] currentDir.pop_back();
+  yyin = NULL;
+}
+
+void releaseFiles(unsigned first) {
+  /* drop sources of the files loaded from 'first' on */
+  while (source.size() > first) {
+    delete source.pop_back();
+    fileNames.pop_back();
+  }
+}
+
 int get_next_char(char *buf) {
   char *line; 
   unsigned n;
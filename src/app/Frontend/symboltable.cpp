@@ -23,25 +23,45 @@
 #include "symboltable.h"
 #include "offsets.h"
 #include "code.h"
+#include "env.h"
 
 using std::cout;
 
 extern Offsets offsets;
 extern void TypeError(String, Pos &);
 
+// sentinel of localStack, distinct from any interned symbol (and NULL)
+static char localMark[] = "<local>";
+
+size_t
+SymbolTable::StringHash::operator()(const char *s) const
+{
+  // FNV-1a
+  size_t h = 2166136261u;
+  while (*s) {
+    h ^= (unsigned char) *s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
 Ident
 SymbolTable::insert(Entry *e)
 {
-  declarationTable[hash(e->string)].push_back(e);
+  declarationTable[e->string].push_back(e);
   identMap.push_back(e);
+  identTypes.push_back(e->monaTypeTag);
   offsets.insert();
   return noIdents++;
 }
 
 void
-SymbolTable::remove(int idx) // must be at end of Deque
+SymbolTable::remove(char *name) // must be at end of Deque
 {
-  declarationTable[idx].pop_back();
+  DeclarationMap::iterator d = declarationTable.find(name);
+  d->second.pop_back();
+  if (d->second.empty())
+    declarationTable.erase(d);
   // don't delete and remove from indentMap since the entry
   // might still be in use
 }
@@ -49,98 +69,59 @@ SymbolTable::remove(int idx) // must be at end of Deque
 SymbolTable::Entry&
 SymbolTable::lookup(Name *name)
 {
-  int idx = hash(name->str);
-
-  for (Entry **e = declarationTable[idx].end();
-       e != declarationTable[idx].begin(); e--) 
-    if ((!(*(e-1))->string && !name->str) ||
-	((*(e-1))->string && name->str && 
-	 strcmp((*(e-1))->string, name->str) == 0))
-      return **(e-1);
+  // symbols are interned, so the declarations are keyed by the pointer
+  DeclarationMap::iterator d = declarationTable.find(name->str);
+  if (d != declarationTable.end() && !d->second.empty())
+    return *d->second.top();
 
   TypeError("'" + String(name->str) + "' not declared", name->pos);
-  exit(-1); // avoid compiler warning
+  abortExecution("not declared"); // avoid compiler warning
 }
 
 void
 SymbolTable::check(Name *name)
 {
-  int idx = hash(name->str);
-  
-  for (Entry **e = declarationTable[idx].begin();
-       e != declarationTable[idx].end(); e++) 
-    if ((*e)->string && name->str && strcmp((*e)->string, name->str) == 0)
-      TypeError("'" + String(name->str) + "' already declared", name->pos);
-}
-
-int
-SymbolTable::hash(char *s) 
-{
-  return (long) s % size;
+  if (name->str && declarationTable.count(name->str))
+    TypeError("'" + String(name->str) + "' already declared", name->pos);
 }
 
-SymbolTable::SymbolTable(int s)
+SymbolTable::SymbolTable(int s) :
+  symbols(s), declarationTable(s)
 {
-  size = s;
   noIdents = 0;
   defaultRestriction1 = NULL;
   defaultRestriction2 = NULL;
-  declarationTable = new Deque<Entry*>[size];
-  symbols = new Deque<char*>[size];
 }
 
 SymbolTable::~SymbolTable()
 {
-  delete[] declarationTable;
-
-  Deque<Entry*>::iterator l;
-  for (l = identMap.begin(); 
-       l != identMap.end(); l++)
-    delete *l;
-  
-  unsigned i;
-  Deque<char*>::iterator j;
-  for (i = 0; i < size; i++)
-    for (j = symbols[i].begin(); j != symbols[i].end(); j++)
-      delete[] *j;
-  delete[] symbols;
+  cleanUp();
 }
 
 void SymbolTable::cleanUp() {
-	  delete[] declarationTable;
+	  declarationTable.clear();
 
 	  Deque<Entry*>::iterator l;
 	  for (l = identMap.begin();
 	       l != identMap.end(); l++)
 	    delete *l;
+	  identMap.reset();
+	  identTypes.clear();
 
-	  unsigned i;
-	  Deque<char*>::iterator j;
-	  for (i = 0; i < size; i++)
-	    for (j = symbols[i].begin(); j != symbols[i].end(); j++)
-	      delete[] *j;
-	  delete[] symbols;
+	  StringSet::iterator j;
+	  for (j = symbols.begin(); j != symbols.end(); j++)
+	    delete[] *j;
+	  symbols.clear();
 }
 
 
 char *
 SymbolTable::insertString(char *str)
 {
-  char *t = str;
-  unsigned idx = 0;
-  while (*t)
-    idx = (idx << 1) + *t++;
-  idx = idx % size;
-
-  char **s;
-  for (s = symbols[idx].begin(); s != symbols[idx].end(); s++)
-    if (strcmp(str, *s) == 0) {
-      delete[] str; // string used before
-      return *s;
-    } 
-
-  symbols[idx].push_back(str); // string never used before
-  return str; 
+  std::pair<StringSet::iterator, bool> s = symbols.insert(str);
+  if (!s.second)
+    delete[] str; // string used before
+  return *s.first;
 }
 
 Ident
@@ -156,7 +137,7 @@ SymbolTable::insertVar(Name *name, MonaTypeTag type,
 		       IdentList *univs, bool local, bool implicit)
 {
   if (local)
-    localStack.push_back(hash(name->str));
+    localStack.push_back(name->str);
   else
     check(name);
   return insert(new VarEntry(name->str, type, noIdents, univs, implicit));
@@ -240,15 +221,39 @@ SymbolTable::insertFresh(MonaTypeTag type, IdentList *univs, bool implicit)
 void 
 SymbolTable::openLocal()
 {
-  localStack.push_back(-1);
+  localStack.push_back(localMark);
 }
 
 void 
 SymbolTable::closeLocal()
 {
-  int i;
-  while ((i = localStack.pop_back()) != -1)
-    remove(i);
+  char *s;
+  while ((s = localStack.pop_back()) != localMark)
+    remove(s);
+}
+
+void
+SymbolTable::release(Ident first) // forget declarations of Idents >= first
+{
+  // entries stay in identMap (like in remove), only names are freed
+  for (Ident id = noIdents; id > first; id--) {
+    Entry *e = identMap.get(id-1);
+    DeclarationMap::iterator d = declarationTable.find(e->string);
+    if (d != declarationTable.end() && d->second.top() == e)
+      remove(e->string);
+  }
+
+  while (!allUnivIds.empty() && allUnivIds.top() >= first)
+    allUnivIds.pop_back();
+  while (!allRealUnivIds.empty() && allRealUnivIds.top() >= first)
+    allRealUnivIds.pop_back();
+  while (!statespaceIds.empty() && statespaceIds.top() >= first)
+    statespaceIds.pop_back();
+
+  if (defaultRestriction1 && defaultIdent1 >= first)
+    defaultRestriction1 = NULL;
+  if (defaultRestriction2 && defaultIdent2 >= first)
+    defaultRestriction2 = NULL;
 }
 
 Ident
@@ -267,7 +272,7 @@ SymbolTable::lookupSymbol(Ident ident)
 MonaTypeTag
 SymbolTable::lookupType(Ident ident)
 {
-  return (identMap.get(ident))->monaTypeTag;
+  return identTypes[ident];
 }
 
 MonaTypeTag
@@ -285,7 +290,7 @@ SymbolTable::lookupStatespaceId(int number)
 int
 SymbolTable::lookupOrder(Ident ident)
 {
-  switch ((identMap.get(ident))->monaTypeTag) {
+  switch (identTypes[ident]) {
   case Varname0:
   case Parname0:
     return 0;
@@ -421,15 +426,7 @@ SymbolTable::lookupSSType(Ident ident)
 bool
 SymbolTable::exists(char *str)
 {
-  int idx = hash(str);
-
-  for (Entry **e = declarationTable[idx].end();
-       e != declarationTable[idx].begin(); e--) 
-    if ((!(*(e-1))->string && !str) ||
-	((*(e-1))->string && str && 
-	 strcmp((*(e-1))->string, str) == 0))
-      return true;
-  return false;
+  return declarationTable.count(str) != 0;
 }
 
 ASTForm*
@@ -21,6 +21,10 @@
 #ifndef __SYMBOLTABLE_H
 #define __SYMBOLTABLE_H
 
+#include <string.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "deque.h"
 #include "ast.h"
 #include "printline.h"
@@ -120,23 +124,33 @@ class SymbolTable {
     IdentList statespaces;
   };
 
+  struct StringHash {
+    size_t operator()(const char *s) const;
+  };
+  struct StringEqual {
+    bool operator()(const char *s, const char *t) const
+    {return strcmp(s, t) == 0;}
+  };
+
+  typedef std::unordered_set<char*, StringHash, StringEqual> StringSet;
+  typedef std::unordered_map<char*, Deque<Entry*> > DeclarationMap;
+
   Ident  insert(Entry*);
-  void   remove(int idx); // must be last-in-first-out order
+  void   remove(char *name); // must be last-in-first-out order
   Entry &lookup(Name*);
   void   check(Name*);
-  int    hash(char*);
 
-  Deque<char*>  *symbols;          // hashtable of symbols
-  Deque<Entry*> *declarationTable; // hashtable String->Entry
-  Deque<int>     localStack;       // stack of hashtable indexes (-1 sentinel) 
+  StringSet      symbols;          // interned symbols (growing hashtable)
+  DeclarationMap declarationTable; // interned symbol->Entry (innermost last)
+  Deque<char*>   localStack;       // stack of local symbols (localMark sentinel)
   Deque<Entry*>  identMap;         // map Ident->Entry
+  std::vector<MonaTypeTag> identTypes; // map Ident->type of the entry
   IdentList      allUnivIds;       // all universe Idents, sorted
   IdentList      allRealUnivIds;   // allUnivIds except dummy
   IdentList      statespaceIds;    // all statespace IDs in order
-  unsigned       size;             // hashtable array size
 
 public:
-   SymbolTable(int size);
+   SymbolTable(int size); // initial number of buckets, the table grows
   ~SymbolTable();
 
   void cleanUp();
@@ -159,6 +173,7 @@ public:
 
   void   openLocal();
   void   closeLocal();
+  void   release(Ident first);
   
   Ident           lookupIdent(Name*);
   char           *lookupSymbol(Ident);
@@ -20,6 +20,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <sstream>
 #include "untyped.h"
 #include "predlib.h"
 #include "env.h"
@@ -43,6 +44,14 @@ bool anyUniverses = false;
 //                                                                           //
 ///////////////////////////////////////////////////////////////////////////////
 
+void
+abortExecution(const std::string &reason)
+{
+  if (options.libraryMode)
+    throw FrontendError(reason);
+  exit(-1);
+}
+
 void
 TypeError(String str, Pos &p)
 {
@@ -52,7 +61,9 @@ TypeError(String str, Pos &p)
     p.printsource();
   }
   cout << "\n" << str << "\n" << "Execution aborted\n";  
-  exit(-1);
+  std::ostringstream reason;
+  reason << str;
+  abortExecution(reason.str());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -625,7 +636,7 @@ UntypedExp_Dot::genAST()
     return new ASTTerm2_Dot((ASTTerm2 *) t, b, pos);
   default:
     TypeError("Type mismatch at '.'", pos);
-    exit(-1);
+    abortExecution("Type mismatch at '.'");
   }
 }
 
@@ -0,0 +1,47 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: Globals.cpp
+ *  Description:
+ *      Definitions of the state shared by the frontend and the decision
+ *      procedure. These are part of the library, so the gaston tool, the
+ *      microbenchmarks and the applications embedding the Solver all link
+ *      against the single copy.
+ *****************************************************************************/
+
+#define _LANGUAGE_C_PLUS_PLUS
+
+// < MONA Frontend Headers >
+#include "Frontend/env.h"
+#include "Frontend/untyped.h"
+#include "Frontend/predlib.h"
+#include "Frontend/ast.h"
+#include "Frontend/code.h"
+#include "Frontend/timer.h"
+#include "Frontend/lib.h"
+#include "Frontend/offsets.h"
+#include "Frontend/ident.h"
+
+// < dWiNA Headers >
+#include <DecisionProcedure/containers/VarToTrackMap.hh>
+
+// < Global variables >
+Options options;
+MonaUntypedAST *untypedAST;
+SymbolTable symbolTable(1019);
+PredicateLib predicateLib;
+Offsets offsets;
+CodeTable *codeTable;
+Guide guide;
+AutLib lib;
+VarToTrackMap varMap;
+int numTypes = 0;
+bool regenerate = false;
+char *inputFileName = NULL;
+Timer timer_conversion, timer_mona, timer_base, timer_automaton;
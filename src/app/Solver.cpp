@@ -0,0 +1,295 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: Solver.cpp
+ *  Description:
+ *      Programmatic interface of the libgaston library.
+ *****************************************************************************/
+
+#define _LANGUAGE_C_PLUS_PLUS
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+#include "Solver.h"
+#include "Frontend/ast.h"
+#include "Frontend/symboltable.h"
+#include "DecisionProcedure/containers/VarToTrackMap.hh"
+#include "DecisionProcedure/containers/SymbolicAutomata.h"
+#include "DecisionProcedure/containers/Workshops.h"
+#include "DecisionProcedure/checkers/SymbolicChecker.h"
+#include "DecisionProcedure/utils/Configuration.h"
+#include "DecisionProcedure/utils/PhaseProfiler.h"
+
+extern Options options;
+extern SymbolTable symbolTable;
+extern VarToTrackMap varMap;
+extern char *inputFileName;
+
+namespace Gaston {
+    Solver* Solver::_instance = nullptr;
+
+    /**
+     * Constructs the solver, that decides the queries with the options @p opts
+     *
+     * @param[in] opts:     options used for each of the queries
+     */
+    Solver::Solver(const Options& opts) : _options(opts), _prelude(nullptr), _captureOutput(true), _recordExamples(true),
+            _isRetaining(true), _zeroSymbolTracks(0) {
+        if(Solver::_instance != nullptr) {
+            throw std::logic_error("only one instance of Gaston::Solver can exist at a time");
+        }
+        Solver::_instance = this;
+        // Errors in the formulae are returned as results instead of terminating the process
+        this->_options.libraryMode = true;
+    }
+
+    Solver::~Solver() {
+        this->_Reset(nullptr);
+        this->_ReleaseRetained();
+        Workshops::SymbolWorkshop::ReleaseZeroSymbol();
+        Workshops::TermWorkshop::ReleaseEmpty();
+        delete this->_prelude;
+        Solver::_instance = nullptr;
+    }
+
+    /**
+     * Loads the predicates and macros from the @p fileName, that are shared by all of the subsequent queries. Any
+     * previously loaded prelude is released.
+     *
+     * @param[in] fileName:     file with the prelude
+     * @return:                 true if the prelude was loaded
+     */
+    bool Solver::LoadPrelude(const std::string& fileName) {
+        // Identifiers of the retained queries were declared after the ones of the prelude
+        this->_ReleaseRetained();
+        delete this->_prelude;
+        this->_prelude = nullptr;
+
+        this->_preludeFileName = fileName;
+        this->_Reset(this->_preludeFileName.c_str());
+        this->_prelude = new SymbolicChecker();
+        try {
+            this->_prelude->LoadFormulaFromFile();
+        } catch (std::exception& e) {
+            delete this->_prelude;
+            this->_prelude = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Decides the formula stored in the @p fileName
+     *
+     * @param[in] fileName:     file with the formula
+     * @return:                 result of the query
+     */
+    Result Solver::DecideFile(const std::string& fileName) {
+        std::string path(fileName);
+        this->_Reset(path.c_str());
+        return this->_Decide([](Checker* checker) { checker->LoadFormulaFromFile(); });
+    }
+
+    /**
+     * Decides the @p formula given in the MONA syntax. The frontend parses files only, so the formula is stored to
+     * the temporary file (in $TMPDIR) first.
+     *
+     * @param[in] formula:      text of the formula
+     * @return:                 result of the query
+     */
+    Result Solver::DecideString(const std::string& formula) {
+        const char* tmpDir = getenv("TMPDIR");
+        std::string tmpPath = std::string(tmpDir != nullptr && *tmpDir != '\0' ? tmpDir : "/tmp") + "/gaston-query-XXXXXX";
+        std::vector<char> tmpName(tmpPath.begin(), tmpPath.end());
+        tmpName.push_back('\0');
+        int fd = mkstemp(tmpName.data());
+        if(fd == -1 || write(fd, formula.c_str(), formula.size()) != static_cast<ssize_t>(formula.size())) {
+            if(fd != -1) {
+                close(fd);
+                unlink(tmpName.data());
+            }
+            Result result;
+            result.error = "cannot store the formula to temporary file";
+            return result;
+        }
+        close(fd);
+
+        Result result = this->DecideFile(tmpName.data());
+        unlink(tmpName.data());
+        return result;
+    }
+
+    /**
+     * Decides the type checked @p ast, whose identifiers are declared in the symbol table. The solver takes the
+     * ownership of the @p ast. The identifiers were declared after the retained queries, so these are released
+     * only with the solver and no further queries are retained.
+     *
+     * @param[in] ast:          type checked formula
+     * @return:                 result of the query
+     */
+    Result Solver::Decide(MonaAST* ast) {
+        this->_isRetaining = false;
+        this->_Reset(nullptr);
+        return this->_Decide([ast](Checker* checker) { checker->LoadFormula(ast); });
+    }
+
+    /**
+     * Resets the global state bound to the formulae (and tracks) of the previous query. The automata shared by
+     * the queries are kept, until the layout of tracks of some query differs (see _ShareWithRetained).
+     *
+     * @param[in] fileName:     file of the next query (or nullptr)
+     */
+    void Solver::_Reset(const char* fileName) {
+        // Headers of the queries (e.g. m2l-str) change the options, so each query starts from the original ones
+        options = this->_options;
+        inputFileName = const_cast<char*>(fileName);
+
+        varMap.clear();
+        Workshops::TermWorkshop::ResetGarbageCounters();
+    }
+
+    /**
+     * Shares the automata of the retained queries with the current (preprocessed) query, if it has the same header
+     * and the same named variables on its tracks. Otherwise the shared automata are released. The zero symbol is
+     * released only if the length of tracks changed.
+     *
+     * @return:     true if the current query shares the automata of the retained queries
+     */
+    bool Solver::_ShareWithRetained() {
+        std::vector<std::string> layout;
+        layout.push_back(std::string(options.m2l ? "m2l-" : "ws") + (options.mode == TREE ? "tree" : "str"));
+        for(unsigned int track = 0; track < varMap.TrackLength(); ++track) {
+            layout.push_back(symbolTable.lookupSymbol(varMap.inverseGet(track)));
+        }
+
+        bool isShared = this->_isRetaining && !this->_retained.empty() && layout == this->_layout;
+        if(isShared) {
+            // Variables of the query are placed on the tracks (and MONA offsets) of the same named variables of the
+            // retained queries, so the shared automata read the same tracks
+            VarToTrackMap queryMap = varMap;
+            varMap = this->_retainedMap;
+            for(unsigned int track = 0; track < queryMap.TrackLength(); ++track) {
+                varMap.alias(queryMap.inverseGet(track), track);
+            }
+        } else {
+            this->_ReleaseShared();
+            this->_layout = layout;
+        }
+
+        if(varMap.TrackLength() != this->_zeroSymbolTracks) {
+            Workshops::SymbolWorkshop::ReleaseZeroSymbol();
+            this->_zeroSymbolTracks = varMap.TrackLength();
+        }
+        return isShared;
+    }
+
+    /**
+     * References the automata stored in the DAG, so they outlive the checker of the current query
+     */
+    void Solver::_HoldShared() {
+        for(auto it = SymbolicAutomaton::dagNodeCache->begin(); it != SymbolicAutomaton::dagNodeCache->end(); ++it) {
+            if(this->_shared.insert(it->second).second) {
+                it->second->IncReferences();
+            }
+        }
+    }
+
+    /**
+     * Retains the @p checker of the decided query, so the DAG can refer its formula. Otherwise the checker is
+     * released together with the retained ones and the automata they share.
+     *
+     * @param[in] checker:          checker of the current query
+     * @param[in] isRetainable:     whether the query was decided and has the layout of the retained ones
+     */
+    void Solver::_RetainQuery(Checker* checker, bool isRetainable) {
+        if(GASTON_OPT(useDag) && this->_isRetaining && isRetainable) {
+            this->_retained.push_back(checker);
+            this->_retainedMap = varMap;
+            return;
+        }
+        // Automata of the DAG may refer the formula of the checker
+        this->_ReleaseShared();
+        delete checker;
+        if(this->_isRetaining) {
+            this->_ReleaseRetained();
+        }
+    }
+
+    /**
+     * Releases the automata shared by the queries
+     */
+    void Solver::_ReleaseShared() {
+        SymbolicAutomaton::dagNodeCache->clear();
+        for(SymbolicAutomaton* automaton : this->_shared) {
+            automaton->DecReferences();
+        }
+        this->_shared.clear();
+    }
+
+    /**
+     * Releases the retained queries together with the automata they share
+     */
+    void Solver::_ReleaseRetained() {
+        this->_ReleaseShared();
+        // Checkers release the identifiers declared from their first one on, hence the later ones go first
+        while(!this->_retained.empty()) {
+            delete this->_retained.back();
+            this->_retained.pop_back();
+        }
+        this->_layout.clear();
+    }
+
+    /**
+     * Runs the whole decision procedure on the formula loaded by @p load
+     *
+     * @param[in] load:     functor loading the formula to the checker
+     * @return:             result of the query
+     */
+    template<class LoadFunctor>
+    Result Solver::_Decide(LoadFunctor load) {
+        Result result;
+        std::ostringstream log;
+        std::streambuf* stdoutBuffer = std::cout.rdbuf();
+        if(this->_captureOutput)
+            std::cout.rdbuf(log.rdbuf());
+
+        std::uint64_t start = PhaseProfiler::Now();
+        SymbolicChecker* checker = new SymbolicChecker();
+        checker->RecordExamples(this->_recordExamples);
+        bool isShared = false;
+        try {
+            load(checker);
+            checker->CloseUngroundFormula();
+            checker->PreprocessFormula();
+            isShared = this->_ShareWithRetained();
+            checker->ConstructAutomaton();
+            this->_HoldShared();
+            checker->Decide();
+            result.decision = checker->GetDecision();
+            result.automatonNodes = checker->GetNodeCount();
+            result.satisfyingExample = checker->GetExample(ExampleType::SATISFYING);
+            result.counterExample = checker->GetExample(ExampleType::UNSATISFYING);
+            if(!result.IsDecided())
+                result.error = "formula uses unsupported construction";
+        } catch (std::exception& e) {
+            result.error = e.what();
+        }
+        this->_RetainQuery(checker, result.error.empty() && (isShared || this->_retained.empty()));
+        result.nanoseconds = PhaseProfiler::Now() - start;
+
+        std::cout.rdbuf(stdoutBuffer);
+        std::cout.clear();
+        result.log = log.str();
+        inputFileName = nullptr;
+        return result;
+    }
+}
@@ -0,0 +1,106 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: Solver.h
+ *  Description:
+ *      Programmatic interface of the libgaston library. The solver decides
+ *      formulae given as files, strings or type checked ASTs and returns
+ *      the decision with the examples and the statistics of the query,
+ *      instead of printing them to the standard output.
+ *
+ *      Errors in the formulae (syntax, types) are returned as the error of
+ *      the result, the frontend does not terminate the process.
+ *
+ *      The frontend keeps its state (symbol table, predicates, options) in
+ *      process-wide globals, hence the solver is the owner of that state:
+ *      only one solver may exist at a time and it resets the state bound
+ *      to the previous query before deciding the next one. Predicates of
+ *      the prelude stay loaded for all of the queries.
+ *
+ *      Consecutive queries with the same variables on the tracks share the
+ *      zero symbol and (with the use-dag switch) the automata of the DAG
+ *      together with their caches; the formulae of such queries are
+ *      retained until the layout of the tracks changes.
+ *****************************************************************************/
+
+#ifndef WSKS_SOLVER_H
+#define WSKS_SOLVER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Frontend/env.h"
+#include "DecisionProcedure/environment.hh"
+#include "DecisionProcedure/containers/VarToTrackMap.hh"
+
+class MonaAST;
+class Checker;
+class SymbolicChecker;
+class SymbolicAutomaton;
+
+namespace Gaston {
+    struct Result {
+        Decision decision = Decision::INVALID;
+        std::string satisfyingExample;      // << Model of the free variables (formulae with free variables only)
+        std::string counterExample;         // << Counter-model of the free variables
+        unsigned int automatonNodes = 0;    // << Number of nodes of the constructed symbolic automaton
+        std::uint64_t nanoseconds = 0;      // << Time spent by the query
+        std::string log;                    // << Output of the procedure, if captured
+        std::string error;                  // << Reason why the formula was not decided
+
+        bool IsDecided() const { return this->decision != Decision::INVALID; }
+    };
+
+    class Solver {
+    public:
+        // <<< PUBLIC CONSTRUCTORS AND DESTRUCTORS >>>
+        explicit Solver(const Options& opts = Options());
+        ~Solver();
+
+        // <<< PUBLIC API >>>
+        bool LoadPrelude(const std::string& fileName);
+        Result DecideFile(const std::string& fileName);
+        Result DecideString(const std::string& formula);
+        Result Decide(MonaAST* ast);
+
+        Options& GetOptions() { return this->_options; }
+        void CaptureOutput(bool capture) { this->_captureOutput = capture; }
+        void RecordExamples(bool record) { this->_recordExamples = record; }
+
+    private:
+        // <<< PRIVATE MEMBERS >>>
+        static Solver* _instance;
+        Options _options;
+        Checker* _prelude;
+        std::string _preludeFileName;
+        bool _captureOutput;
+        bool _recordExamples;
+
+        // State shared by the consecutive queries with the same layout of tracks
+        bool _isRetaining;                                  // << False once the query was given as AST
+        std::vector<Checker*> _retained;                    // << Checkers of the queries, whose formulae the DAG refers to
+        std::unordered_set<SymbolicAutomaton*> _shared;     // << Automata of the DAG referenced by the solver
+        std::vector<std::string> _layout;                   // << Header and names of variables on the tracks
+        VarToTrackMap _retainedMap;                         // << Tracks of the variables of the retained queries
+        unsigned int _zeroSymbolTracks;                     // << Length of tracks the zero symbol was created for
+
+        // <<< PRIVATE METHODS >>>
+        void _Reset(const char* fileName);
+        bool _ShareWithRetained();
+        void _HoldShared();
+        void _RetainQuery(Checker* checker, bool isShared);
+        void _ReleaseShared();
+        void _ReleaseRetained();
+        template<class LoadFunctor>
+        Result _Decide(LoadFunctor load);
+    };
+}
+
+#endif //WSKS_SOLVER_H
@@ -21,12 +21,17 @@
 // < System Headers >
 #include <iostream>
 #include <fstream>
+#include <iomanip>
 #include <new>
+#include <sstream>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <signal.h>
 #include <list>
 #include <map>
+#include <streambuf>
+#include <cstdio>
+#include <unistd.h>
 
 // < VATA Headers >
 #include <vata/bdd_bu_tree_aut.hh>
@@ -57,6 +62,12 @@
 #include "DecisionProcedure/containers/SymbolicAutomata.h"
 #include "DecisionProcedure/containers/Term.h"
 #include "DecisionProcedure/checkers/SymbolicChecker.h"
+#include "DecisionProcedure/checkers/IncrementalChecker.h"
+#include "DecisionProcedure/utils/Configuration.h"
+#include "DecisionProcedure/utils/Tracer.h"
+#include "DecisionProcedure/utils/PhaseProfiler.h"
+#include "DecisionProcedure/utils/MemoryAccounting.h"
+#include "Solver.h"
 
 // < Typedefs and usings >
 using std::cout;
@@ -68,19 +79,14 @@ using Automaton 			 = VATA::BDDBottomUpTreeAut;
 typedef unsigned int uint;
 
 // < Global variables >
-Options options;
-MonaUntypedAST *untypedAST;
-SymbolTable symbolTable(1019);
-PredicateLib predicateLib;
-Offsets offsets;
-CodeTable *codeTable;
-Guide guide;
-AutLib lib;
-VarToTrackMap varMap;
-int numTypes = 0;
-bool regenerate = false;
-char *inputFileName = NULL;
-Timer timer_conversion, timer_mona, timer_base, timer_automaton;
+// Note: the state shared with the library is defined in Globals.cpp
+extern Options options;
+extern VarToTrackMap varMap;
+extern char *inputFileName;
+char *profileFileName = NULL;
+char *preludeFileName = NULL;
+bool batchMode = false;
+bool incrementalMode = false;
 Timer timer_gaston;
 
 //extern void (*mona_callback)();
@@ -106,7 +112,20 @@ void PrintUsage() {
 		<< " -e, --expand-tagged Expand automata with given tag on first line of formula\n"
 		<< " -q, --quiet		 Quiet, don't print progress\n"
 		<< " -oX                 Optimization level [1 = safe optimizations [default], 2 = heuristic]\n"
-		<< "Example: ./gaston -t -d foo.mona\n\n";
+		<< "     --enable=<opt>  Enable the optimization switch\n"
+		<< "     --disable=<opt> Disable the optimization switch\n"
+		<< "     --config=<file> Load optimization switches from file (lines of form '<opt> = on|off')\n"
+		<< "     --trace=<file>  Write the timeline of decision procedure as Chrome trace JSON\n"
+		<< "     --profile=<file> Export time and memory of the phases as JSON\n"
+		<< "     --batch         Decide every formula listed in <filename> (one file per line), '-' reads\n"
+		<< "                     formulas from stdin separated by lines '---'; prints one result line per formula\n"
+		<< "     --prelude=<file> Predicates and macros shared by all formulas of the batch\n"
+		<< "     --incremental   Run the script <filename> ('-' for stdin) of commands 'assert <file>',\n"
+		<< "                     'push <file>', 'pop' and 'check' deciding the conjunction incrementally\n"
+		<< "Example: ./gaston -t -d foo.mona\n\n"
+		<< "Optimization switches [default]:\n";
+	Gaston::Configuration::PrintSwitches();
+	cout << "\n";
 }
 
 /**
@@ -159,6 +178,25 @@ bool ParseArguments(int argc, char *argv[]) {
 				options.test = TestType::SATISFIABILITY;
 			} else if(strcmp(argv[i], "--test=unsat") == 0) {
 				options.test = TestType::UNSATISFIABILITY;
+			} else if(strncmp(argv[i], "--enable=", 9) == 0) {
+				if(!Gaston::config.Set(argv[i] + 9, true))
+					return false;
+			} else if(strncmp(argv[i], "--disable=", 10) == 0) {
+				if(!Gaston::config.Set(argv[i] + 10, false))
+					return false;
+			} else if(strncmp(argv[i], "--config=", 9) == 0) {
+				if(!Gaston::config.LoadFromFile(argv[i] + 9))
+					return false;
+			} else if(strncmp(argv[i], "--trace=", 8) == 0) {
+				Gaston::Trace::Enable(argv[i] + 8);
+			} else if(strncmp(argv[i], "--profile=", 10) == 0) {
+				profileFileName = argv[i] + 10;
+			} else if(strcmp(argv[i], "--batch") == 0) {
+				batchMode = true;
+			} else if(strcmp(argv[i], "--incremental") == 0) {
+				incrementalMode = true;
+			} else if(strncmp(argv[i], "--prelude=", 10) == 0) {
+				preludeFileName = argv[i] + 10;
 			} else {
 				switch (argv[i][1]) {
 					case 'e':
@@ -187,6 +225,192 @@ bool ParseArguments(int argc, char *argv[]) {
 	return true;
 }
 
+/**
+ * Stream buffer that throws away everything, used to silence the checkers in the batch mode
+ */
+class NullBuffer : public std::streambuf {
+protected:
+	int overflow(int c) { return c; }
+};
+
+/**
+ * Prints the tab separated result line of the query
+ *
+ * @param[in] name:         name of the query
+ * @param[in] decision:     decision of the query
+ * @param[in] nanoseconds:  time spent by the query
+ * @return:                 false if the query was not decided
+ */
+bool PrintResult(const std::string& name, Decision decision, std::uint64_t nanoseconds) {
+	std::cout << name << "\t";
+	switch(decision) {
+		case Decision::SATISFIABLE:
+			std::cout << "SATISFIABLE";
+			break;
+		case Decision::UNSATISFIABLE:
+			std::cout << "UNSATISFIABLE";
+			break;
+		case Decision::VALID:
+			std::cout << "VALID";
+			break;
+		default:
+			std::cout << "ERROR";
+			break;
+	}
+	std::cout << "\t" << std::fixed << std::setprecision(3) << (nanoseconds / 1e6) << "ms" << std::endl;
+	return decision != Decision::INVALID;
+}
+
+/**
+ * Returns the next query of the batch: either the next (non-empty, non-comment) line of the list of files, or the
+ * next formula from the stdin
+ *
+ * @param[in] input:        list of files or stream of formulas
+ * @param[in] fromStdin:    whether the @p input is stream of formulas
+ * @param[out] query:       path to the file with the query, or the text of the formula
+ * @return:                 false if there are no more queries
+ */
+bool NextQuery(std::istream& input, bool fromStdin, std::string& query) {
+	std::string line;
+	if(!fromStdin) {
+		while(std::getline(input, line)) {
+			size_t begin = line.find_first_not_of(" \t\r");
+			if(begin == std::string::npos || line[begin] == '#')
+				continue;
+			query = line.substr(begin, line.find_last_not_of(" \t\r") + 1 - begin);
+			return true;
+		}
+		return false;
+	}
+
+	std::string formula;
+	bool isBlank = true;
+	while(std::getline(input, line)) {
+		if(line == "---" || line == "---\r") {
+			if(isBlank)
+				continue;
+			break;
+		}
+		isBlank = isBlank && line.find_first_not_of(" \t\r") == std::string::npos;
+		formula += line + "\n";
+	}
+	query = formula;
+	return !isBlank;
+}
+
+/**
+ * Decides the formulae of the batch one by one in the single process. The prelude (if any) is parsed only once and
+ * its predicates are shared by all of the queries. Consecutive queries with the same variables share the automata
+ * of the DAG and their caches (with --enable=use-dag), everything else declared by the query is released after it
+ * is decided. Output of the checkers is suppressed (unless dumping), instead one line with the name of the query,
+ * the decision and the time in ms is printed for each query.
+ *
+ * @param[in] listFileName:     list of files with formulae, or '-' for formulae on stdin
+ */
+void DecideBatch(char* listFileName) {
+	bool fromStdin = strcmp(listFileName, "-") == 0;
+	std::ifstream listFile;
+	if(!fromStdin) {
+		listFile.open(listFileName);
+		if(!listFile) {
+			cerr << "[!] Cannot open the list of formulae '" << listFileName << "'\n";
+			exit(-1);
+		}
+	}
+	std::istream& input = fromStdin ? std::cin : listFile;
+
+	// Output of the checkers is passed through only when dumping
+	Gaston::Solver solver(options);
+	solver.CaptureOutput(!options.dump);
+	solver.RecordExamples(false);
+	if(preludeFileName != NULL && !solver.LoadPrelude(preludeFileName)) {
+		cerr << "[!] Cannot load the prelude '" << preludeFileName << "'\n";
+		exit(-1);
+	}
+
+	std::string query;
+	size_t queries = 0, failures = 0;
+	while(NextQuery(input, fromStdin, query)) {
+		++queries;
+		std::string name = fromStdin ? "#" + std::to_string(queries) : query;
+		Gaston::Result result = fromStdin ? solver.DecideString(query) : solver.DecideFile(query);
+		if(!result.error.empty())
+			cerr << "[!] " << name << ": " << result.error << "\n";
+		if(!PrintResult(name, result.decision, result.nanoseconds))
+			++failures;
+	}
+
+	std::cout << "[*] Decided " << (queries - failures) << "/" << queries << " formulae\n";
+}
+
+/**
+ * Runs the script of the incremental session. Each line is one of the commands: 'assert <file>' starts the session
+ * with the background formula, 'push <file>' adds the conjunct, 'pop' removes the last conjunct and 'check'
+ * decides the conjunction and prints the result line. Lines starting with '#' are skipped.
+ *
+ * @param[in] scriptFileName:   file with the script, or '-' for stdin
+ */
+void RunIncremental(char* scriptFileName) {
+	std::ifstream scriptFile;
+	if(strcmp(scriptFileName, "-") != 0) {
+		scriptFile.open(scriptFileName);
+		if(!scriptFile) {
+			cerr << "[!] Cannot open the script '" << scriptFileName << "'\n";
+			exit(-1);
+		}
+	}
+	std::istream& script = scriptFile.is_open() ? static_cast<std::istream&>(scriptFile) : std::cin;
+
+	NullBuffer nullBuffer;
+	std::streambuf* stdoutBuffer = std::cout.rdbuf();
+	IncrementalChecker checker;
+	bool asserted = false;
+	size_t checks = 0, lineNo = 0;
+	std::string line;
+	while(std::getline(script, line)) {
+		++lineNo;
+		std::istringstream tokens(line);
+		std::string command, argument;
+		tokens >> command >> argument;
+		if(command.empty() || command[0] == '#')
+			continue;
+
+		if(!options.dump)
+			std::cout.rdbuf(&nullBuffer);
+		std::uint64_t start = Gaston::PhaseProfiler::Now();
+		Decision decision = Decision::INVALID;
+		bool isValidCommand = true;
+		try {
+			if(command == "assert" && !argument.empty()) {
+				checker.Assert(argument.c_str());
+				asserted = true;
+			} else if(command == "push" && !argument.empty() && asserted) {
+				checker.Push(argument.c_str());
+			} else if(command == "pop" && checker.Depth() > 0) {
+				checker.Pop();
+			} else if(command == "check" && asserted) {
+				checker.ConstructAutomaton();
+				checker.Decide();
+				decision = checker.GetDecision();
+			} else {
+				isValidCommand = false;
+			}
+		} catch (std::exception& e) {
+			cerr << "[!] line " << lineNo << ": " << e.what() << "\n";
+		}
+		std::uint64_t end = Gaston::PhaseProfiler::Now();
+		std::cout.rdbuf(stdoutBuffer);
+		std::cout.clear();
+
+		if(!isValidCommand) {
+			cerr << "[!] line " << lineNo << ": invalid command '" << line << "'\n";
+		} else if(command == "check") {
+			PrintResult("#" + std::to_string(++checks) + " (depth " + std::to_string(checker.Depth()) + ")", decision, end - start);
+		}
+	}
+	std::cout << "[*] Rebuilt the automata " << checker.Rebuilds() << " times for new variables\n";
+}
+
 int main(int argc, char *argv[]) {
 	/* Parse initial arguments */
 	if (!ParseArguments(argc, argv)) {
@@ -194,8 +418,40 @@ int main(int argc, char *argv[]) {
 		exit(-1);
 	}
 	initTimer();
+	if(options.time || profileFileName != NULL) {
+		Gaston::profiler.Enable();
+	}
+#if (MEASURE_MEMORY == true)
+	Gaston::Memory::InstallReportHandler();
+#endif
+
+	if(options.dump) {
+		std::cout << "[*] Optimization switches:\n";
+		Gaston::config.Dump();
+	}
 
 	timer_gaston.start();
+	if(batchMode || incrementalMode) {
+		if(batchMode)
+			DecideBatch(inputFileName);
+		else
+			RunIncremental(inputFileName);
+		timer_gaston.stop();
+		std::cout << "[*] Total elapsed time: ";
+		timer_gaston.print();
+		Gaston::Trace::Flush();
+		if(options.time) {
+			Gaston::profiler.Dump();
+#if (MEASURE_MEMORY == true)
+			Gaston::Memory::Dump();
+#endif
+		}
+		if(profileFileName != NULL) {
+			Gaston::profiler.ExportJSON(profileFileName);
+		}
+		return 0;
+	}
+
     Checker *checker = new SymbolicChecker();
     checker->LoadFormulaFromFile();
     checker->CloseUngroundFormula();
@@ -212,6 +468,16 @@ int main(int argc, char *argv[]) {
 	timer_gaston.stop();
 	std::cout << "\n[*] Total elapsed time: ";
 	timer_gaston.print();
+	Gaston::Trace::Flush();
+	if(options.time) {
+		Gaston::profiler.Dump();
+#if (MEASURE_MEMORY == true)
+		Gaston::Memory::Dump();
+#endif
+	}
+	if(profileFileName != NULL) {
+		Gaston::profiler.ExportJSON(profileFileName);
+	}
 
     delete checker;
 
@@ -0,0 +1,437 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *
+ *  File: microbench.cpp
+ *  Description:
+ *      Microbenchmarks of the hot paths of the decision procedure. Each
+ *      benchmark is repeated until it runs for at least the minimal time
+ *      and reports nanoseconds and heap allocations per operation, so the
+ *      changes of single operations can be judged in isolation.
+ *
+ *      Subsumption, intersection of base sets and cache operations run on
+ *      synthetic inputs. Pre of MONA wrappers and base automata, symbol
+ *      creation and iteration of fixpoints run on the automaton of the
+ *      formula given on the command line.
+ *****************************************************************************/
+
+#define _LANGUAGE_C_PLUS_PLUS
+
+// < System Headers >
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// < MONA Frontend Headers >
+#include "Frontend/bdd.h"
+#include "Frontend/env.h"
+#include "Frontend/untyped.h"
+#include "Frontend/predlib.h"
+#include "Frontend/ast.h"
+#include "Frontend/code.h"
+#include "Frontend/timer.h"
+#include "Frontend/lib.h"
+#include "Frontend/offsets.h"
+#include "Frontend/ident.h"
+
+// < dWiNA Headers >
+#include <DecisionProcedure/environment.hh>
+#include <DecisionProcedure/containers/VarToTrackMap.hh>
+#include "DecisionProcedure/automata.hh"
+#include "DecisionProcedure/containers/SymbolicAutomata.h"
+#include "DecisionProcedure/containers/Term.h"
+#include "DecisionProcedure/containers/Workshops.h"
+#include "DecisionProcedure/checkers/SymbolicChecker.h"
+#include "DecisionProcedure/mtbdd/monawrapper.hh"
+
+// < Global variables (defined in Globals.cpp of the library) >
+extern Options options;
+extern VarToTrackMap varMap;
+extern char *inputFileName;
+
+// < Counting of heap allocations >
+static size_t heapAllocations = 0;
+
+void* operator new(size_t size) {
+    ++heapAllocations;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if(p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Sink for the results of benchmarks, so the benchmarked calls are not optimized away
+    volatile size_t sink = 0;
+
+    struct BenchOptions {
+        const char* filter = nullptr;
+        double minTime = 0.2;
+        char* formula = nullptr;
+    } benchOptions;
+
+    /**
+     * Checker that exposes the constructed automaton
+     */
+    class BenchChecker : public SymbolicChecker {
+    public:
+        SymbolicAutomaton* GetAutomaton() { return this->_automaton; }
+    };
+
+    /**
+     * Runs the benchmark @p body until it takes at least the minimal time and prints ns/op and allocations/op.
+     * Each call of the @p body returns the number of operations it performed.
+     *
+     * @param[in] name:     name of the benchmark
+     * @param[in] body:     benchmarked function
+     */
+    void Run(const std::string& name, const std::function<size_t()>& body) {
+        if(benchOptions.filter != nullptr && name.find(benchOptions.filter) == std::string::npos) {
+            return;
+        }
+
+        // Warm up, so the caches are filled and the lazy structures initialized
+        body();
+
+        size_t iterations = 1;
+        while(true) {
+            size_t ops = 0;
+            size_t allocationsBefore = heapAllocations;
+            auto start = Clock::now();
+            for(size_t i = 0; i < iterations; ++i) {
+                ops += body();
+            }
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            size_t allocations = heapAllocations - allocationsBefore;
+
+            if(elapsed >= benchOptions.minTime || iterations >= (static_cast<size_t>(1) << 40)) {
+                ops = (ops == 0 ? 1 : ops);
+                std::cout << "\t\u2218 " << std::left << std::setw(48) << name << std::right;
+                std::cout << std::fixed << std::setprecision(2) << std::setw(12) << (elapsed*1e9 / ops) << " ns/op";
+                std::cout << std::setw(10) << (allocations / static_cast<double>(ops)) << " allocs/op";
+                std::cout << "  (" << ops << " ops)\n";
+                return;
+            }
+            iterations *= (elapsed < benchOptions.minTime / 16 ? 16 : 2);
+        }
+    }
+
+    /**
+     * Generates the sorted set of @p size states from [0, @p universe) using the @p generator
+     */
+    BaseAutomatonStateSet RandomStates(std::mt19937& generator, size_t size, size_t universe) {
+        std::uniform_int_distribution<size_t> distribution(0, universe - 1);
+        BaseAutomatonStateSet states;
+        while(states.size() < size) {
+            states.insert(distribution(generator));
+        }
+        return states;
+    }
+
+    // <<< SYNTHETIC BENCHMARKS >>>
+    void BenchBaseSets(std::mt19937& generator) {
+        for(size_t size : {8, 64, 512}) {
+            BaseAutomatonStateSet bigger = RandomStates(generator, size, 4*size);
+            // Smaller set is subsumed, the other one differs only in the greatest state, i.e. both are worst cases
+            BaseAutomatonStateSet smaller(bigger.begin(), bigger.begin() + size/2);
+            BaseAutomatonStateSet different(smaller);
+            different.insert(4*size);
+            BaseAutomatonStateSet disjoint;
+            for(auto state : bigger) {
+                disjoint.insert(state + 4*size);
+            }
+
+            TermBaseSet* bigTerm = new TermBaseSet(bigger, 0, 8*size);
+            TermBaseSet* smallTerm = new TermBaseSet(smaller, 0, 8*size);
+            TermBaseSet* differentTerm = new TermBaseSet(different, 0, 8*size);
+            TermBaseSet* disjointTerm = new TermBaseSet(disjoint, 0, 8*size);
+            std::string suffix = "/" + std::to_string(size);
+
+            Run("TermBaseSet::IsSubsumed(true)" + suffix, [=]() {
+                sink += smallTerm->IsSubsumed(bigTerm);
+                return 1;
+            });
+            Run("TermBaseSet::IsSubsumed(false)" + suffix, [=]() {
+                sink += differentTerm->IsSubsumed(bigTerm);
+                return 1;
+            });
+            Run("TermBaseSet::Intersects(true)" + suffix, [=]() {
+                sink += smallTerm->Intersects(bigTerm);
+                return 1;
+            });
+            Run("TermBaseSet::Intersects(false)" + suffix, [=]() {
+                sink += disjointTerm->Intersects(bigTerm);
+                return 1;
+            });
+
+            // Products of the base sets, both components have to be tested
+            TermProduct* smallProduct = new TermProduct(smallTerm, smallTerm, E_INTERSECTION);
+            TermProduct* bigProduct = new TermProduct(bigTerm, bigTerm, E_INTERSECTION);
+            TermProduct* differentProduct = new TermProduct(smallTerm, differentTerm, E_INTERSECTION);
+            TermProduct* mixedProduct = new TermProduct(bigTerm, smallTerm, E_INTERSECTION);
+            Run("TermProduct::IsSubsumed(true)" + suffix, [=]() {
+                sink += smallProduct->IsSubsumed(bigProduct);
+                return 1;
+            });
+            Run("TermProduct::IsSubsumed(false)" + suffix, [=]() {
+                sink += differentProduct->IsSubsumed(mixedProduct);
+                return 1;
+            });
+        }
+    }
+
+    void BenchCaches(std::mt19937& generator) {
+        const size_t termNo = 1024;
+        std::vector<Term_ptr> terms;
+        for(size_t i = 0; i < termNo; ++i) {
+            BaseAutomatonStateSet states = RandomStates(generator, 4, 64);
+            terms.push_back(new TermBaseSet(states, 0, 64));
+        }
+        std::vector<SubsumptionKey> keys;
+        for(size_t i = 0; i < termNo; ++i) {
+            keys.push_back(std::make_pair(terms[i], terms[(i*7 + 1) % termNo]));
+        }
+        std::vector<SubsumptionKey> missingKeys;
+        for(size_t i = 0; i < termNo; ++i) {
+            missingKeys.push_back(std::make_pair(terms[(i*7 + 1) % termNo], terms[i]));
+        }
+
+        Run("BinaryCache::StoreIn", [&]() {
+            SubsumptionCache cache;
+            for(auto& key : keys) {
+                cache.StoreIn(key, E_TRUE);
+            }
+            return keys.size();
+        });
+
+        SubsumptionCache filledCache;
+        for(auto& key : keys) {
+            filledCache.StoreIn(key, E_TRUE);
+        }
+        Run("BinaryCache::retrieveFromCache(hit)", [&]() {
+            SubsumptionResult result;
+            for(auto& key : keys) {
+                sink += filledCache.retrieveFromCache(key, result);
+            }
+            return keys.size();
+        });
+        Run("BinaryCache::retrieveFromCache(miss)", [&]() {
+            SubsumptionResult result;
+            for(auto& key : missingKeys) {
+                sink += filledCache.retrieveFromCache(key, result);
+            }
+            return missingKeys.size();
+        });
+    }
+
+    // <<< BENCHMARKS DERIVED FROM FORMULA >>>
+    /**
+     * Returns the symbols used for benchmarking: zero symbol and symbols with each of the tracks set to 1 and X
+     */
+    std::vector<Symbol*> CreateSymbols(Workshops::SymbolWorkshop& workshop) {
+        std::vector<Symbol*> symbols;
+        Symbol* zero = Workshops::SymbolWorkshop::CreateZeroSymbol();
+        symbols.push_back(zero);
+        for(size_t var = 0; var < varMap.TrackLength(); ++var) {
+            symbols.push_back(workshop.CreateSymbol(zero, var, '1'));
+            symbols.push_back(workshop.CreateSymbol(zero, var, 'X'));
+        }
+        return symbols;
+    }
+
+    void BenchSymbols(std::vector<BaseAutomaton*>& bases) {
+        Workshops::SymbolWorkshop* workshop = new Workshops::SymbolWorkshop();
+        std::vector<Symbol*> symbols = CreateSymbols(*workshop);
+        size_t trackLength = varMap.TrackLength();
+
+        Run("SymbolWorkshop::CreateSymbol", [=]() {
+            for(auto symbol : symbols) {
+                for(size_t var = 0; var < trackLength; ++var) {
+                    sink += reinterpret_cast<size_t>(workshop->CreateSymbol(symbol, var, (var & 1) ? '1' : 'X'));
+                }
+            }
+            return symbols.size()*trackLength;
+        });
+
+        if(bases.empty()) {
+            return;
+        }
+        Run("SymbolWorkshop::CreateTrimmedSymbol", [=]() {
+            for(auto symbol : symbols) {
+                for(auto base : bases) {
+                    sink += reinterpret_cast<size_t>(workshop->CreateTrimmedSymbol(symbol, base->GetFreeVars()));
+                }
+            }
+            return symbols.size()*bases.size();
+        });
+    }
+
+    void BenchPre(std::vector<BaseAutomaton*>& bases) {
+        if(bases.empty()) {
+            return;
+        }
+
+        Workshops::SymbolWorkshop* workshop = new Workshops::SymbolWorkshop();
+        std::vector<Symbol*> symbols = CreateSymbols(*workshop);
+
+        // Wrappers are constructed from the same MONA automata as the wrappers of base automata
+        std::vector<std::pair<MonaWrapper<size_t>*, size_t>> wrappers;
+        for(auto base : bases) {
+            DFA* dfa = nullptr;
+            IdentList free, bound;
+            base->_form->freeVars(&free, &bound);
+            toMonaAutomaton(base->_form, dfa, true);
+            bool hasEmptyTracks = (free.empty() && base->_form->kind != aTrue && base->_form->kind != aFalse) || dfa->ns == 1;
+            size_t stateNo = dfa->ns;
+            wrappers.push_back(std::make_pair(new MonaWrapper<size_t>(dfa, hasEmptyTracks, varMap.TrackLength()), stateNo));
+        }
+
+        Run("MonaWrapper::Pre", [&]() {
+            size_t ops = 0;
+            for(auto& wrapper : wrappers) {
+                for(size_t state = 0; state < wrapper.second; ++state) {
+                    for(auto symbol : symbols) {
+                        sink += wrapper.first->Pre(state, symbol->GetTrackMask()).size();
+                        ++ops;
+                    }
+                }
+            }
+            return ops;
+        });
+
+        Run("BaseAutomaton::Pre", [&]() {
+            size_t ops = 0;
+            for(auto base : bases) {
+                Term* finalStates = base->GetFinalStates();
+                for(auto symbol : symbols) {
+                    sink += reinterpret_cast<size_t>(base->Pre(symbol, finalStates, false));
+                    ++ops;
+                }
+            }
+            return ops;
+        });
+    }
+
+    void BenchFixpoint(SymbolicAutomaton* automaton) {
+        ResultType result = automaton->IntersectNonEmpty(nullptr, automaton->GetFinalStates(), false);
+        if(result.first->type != TERM_FIXPOINT) {
+            std::cout << "\t\u2218 TermFixpoint::iterator skipped (the root of the automaton is not a projection)\n";
+            return;
+        }
+
+        TermFixpoint* fixpoint = reinterpret_cast<TermFixpoint*>(result.first);
+        Run("TermFixpoint::iterator::GetNext", [=]() {
+            size_t ops = 1;
+            auto it = fixpoint->GetIterator();
+            for(Term_ptr term = it.GetNext(); term != nullptr; term = it.GetNext()) {
+                sink += reinterpret_cast<size_t>(term);
+                ++ops;
+            }
+            return ops;
+        });
+    }
+
+    /**
+     * Collects the base automata of the @p automaton, each shared one only once
+     */
+    std::vector<BaseAutomaton*> CollectBases(SymbolicAutomaton* automaton) {
+        std::vector<BaseAutomaton*> bases;
+        automaton->CollectBases(bases);
+        std::sort(bases.begin(), bases.end());
+        bases.erase(std::unique(bases.begin(), bases.end()), bases.end());
+        return bases;
+    }
+
+    void PrintUsage() {
+        std::cout << "Usage: gaston_microbench [options] [<filename>]\n\n"
+            << "Options:\n"
+            << "     --filter=<str>   Run only benchmarks whose name contains the string\n"
+            << "     --min-time=<ms>  Minimal time of each benchmark [200]\n"
+            << "Benchmarks of Pre, symbols and fixpoints are run only if the formula is given.\n";
+    }
+
+    bool ParseArguments(int argc, char *argv[]) {
+        for(int i = 1; i < argc; ++i) {
+            if(strncmp(argv[i], "--filter=", 9) == 0) {
+                benchOptions.filter = argv[i] + 9;
+            } else if(strncmp(argv[i], "--min-time=", 11) == 0) {
+                benchOptions.minTime = atof(argv[i] + 11) / 1000.0;
+            } else if(argv[i][0] != '-' && i == argc - 1) {
+                benchOptions.formula = argv[i];
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if(!ParseArguments(argc, argv)) {
+        PrintUsage();
+        return -1;
+    }
+    initTimer();
+    options.printProgress = false;
+    options.optimize = 1;
+
+    std::mt19937 generator(2016);
+    std::cout << "[*] Synthetic benchmarks:\n";
+    BenchBaseSets(generator);
+    BenchCaches(generator);
+
+    if(benchOptions.formula == nullptr) {
+        return 0;
+    }
+
+    inputFileName = benchOptions.formula;
+    BenchChecker* checker = new BenchChecker();
+    checker->LoadFormulaFromFile();
+    checker->CloseUngroundFormula();
+    checker->PreprocessFormula();
+    checker->ConstructAutomaton();
+
+    std::vector<BaseAutomaton*> bases = CollectBases(checker->GetAutomaton());
+    std::cout << "[*] Benchmarks on '" << benchOptions.formula << "' (" << bases.size() << " base automata):\n";
+    BenchSymbols(bases);
+    BenchPre(bases);
+    BenchFixpoint(checker->GetAutomaton());
+
+    return 0;
+}
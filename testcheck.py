@@ -14,6 +14,7 @@ import os
 import re
 import subprocess
 import sys
+import tempfile
 from threading import Timer
 from termcolor import colored
 
@@ -21,6 +22,7 @@ dwina_error = (-1, -1, -1, -1, -1, -1, -1)
 timeout_error = (-2, -2, -2, -2, -2, -2, -2)
 mona_error = (-1, -1)
 mona_expnf_error = (-1, -1, -1)
+batch_results = None
 
 
 def createArgumentParser():
@@ -32,6 +34,9 @@ def createArgumentParser():
     parser.add_argument('--timeout', '-t', default=None, help='timeouts in minutes')
     parser.add_argument('--check', '-c', action='store_true', help='run the regression testing')
     parser.add_argument('--check-mem', '-cm', action='store_true', help='runs the valgrind during testing as well')
+    parser.add_argument('--enable', '-e', action='append', default=[], help='optimization switch enabled in gaston')
+    parser.add_argument('--disable', '-x', action='append', default=[], help='optimization switch disabled in gaston')
+    parser.add_argument('--batch', '-b', action='store_true', help='decide all benchmarks by one gaston process (--batch)')
     return parser
 
 
@@ -46,12 +51,45 @@ def run_mona(test, timeout, checkonly=False):
     return parseMonaOutput(output, False, checkonly)
 
 
+def gaston_switches():
+    '''
+    Returns the optimization switches of gaston given by --enable and --disable
+    '''
+    return tuple('--enable={}'.format(opt) for opt in options.enable) + \
+        tuple('--disable={}'.format(opt) for opt in options.disable)
+
+
+def run_gaston_batch(tests, timeout):
+    '''
+    Runs gaston in the batch mode on all of the tests, consecutive queries thus share the automata
+
+    @param tests: list of the tests
+    @return dictionary of the results of the tests
+    '''
+    gaston_bin = os.path.join(os.path.dirname(os.path.realpath(__file__)), 'build/gaston')
+    with tempfile.NamedTemporaryFile('w', suffix='.list', delete=False) as list_file:
+        list_file.write("\n".join(tests) + "\n")
+    args = (gaston_bin, '--batch', '--test=val') + gaston_switches() + ('"{}"'.format(list_file.name), )
+    output, retcode = runProcess(args, timeout)
+    os.remove(list_file.name)
+
+    results = {}
+    for line in output:
+        match = re.search("^(.*)\t([A-Z]+)\t[0-9.]+ms$", line.rstrip())
+        if match is not None:
+            results[match.group(1)] = match.group(2)
+    return results
+
+
 def run_gaston(test, timeout, checkonly=False):
     '''
     Runs dWiNA with following arguments: --method=backward
     '''
+    if batch_results is not None:
+        ret = batch_results.get(test, "")
+        return (dwina_error, "") if ret in ("", "ERROR") else ((-1, -1, -1, -1, -1), ret)
     gaston_bin = os.path.join(os.path.dirname(os.path.realpath(__file__)), 'build/gaston')
-    args = (gaston_bin, '--test=val', '"{}"'.format(test))
+    args = (gaston_bin, '--test=val') + gaston_switches() + ('"{}"'.format(test), )
     output, retcode = runProcess(args, timeout)
 
     # Fixme: This should be the issue of segfault
@@ -180,6 +218,10 @@ if __name__ == '__main__':
     # wdir = os.path.join(os.curdir, "tests", options.dir)\
     wdir = os.path.join(os.path.dirname(os.path.realpath(__file__)), "tests", options.dir)
 
+    if options.batch:
+        tests = [os.path.join(root, f) for root, dirs, filenames in os.walk(wdir) for f in filenames if f.endswith('.mona')]
+        batch_results = run_gaston_batch(sorted(tests), options.timeout)
+
     # iterate through all files in dir
     cases = 0
     all_cases = []
@@ -245,5 +287,6 @@ if __name__ == '__main__':
         print(colored("'testbench-fail.log'", "grey", attrs=["bold"]))
         with open('testbench-fail.log', 'w') as fc_file:
             fc_file.write("\n".join(failed_cases))
+        sys.exit(1)
     else:
         print(colored("passed", "green", attrs=["bold"]))
@@ -9,6 +9,7 @@
 import argparse
 from datetime import datetime
 import itertools
+import json
 import os
 import re
 import subprocess
@@ -25,6 +26,14 @@ def createArgumentParser():
     parser.add_argument('--dir', '-d', default=(os.path.join(os.curdir, "benchmarks")), help="directory with benchmarks")
     parser.add_argument('--generate', '-g', default=None, nargs=2, help='generates parametrized benchmark up to N')
     parser.add_argument('--generate-alt', '-a', default=None, nargs=3, help='generates parametrized benchmarks up to N with ALT alternation')
+    parser.add_argument('--series', '-S', default=None, nargs=3, metavar=('PARAM', 'FROM', 'TO'),
+                        help='generates scaling series sweeping PARAM ({}) from FROM to TO'.format(", ".join(series_params)))
+    parser.add_argument('--step', default=1, type=int, help='step of the swept parameter of the series')
+    parser.add_argument('--logic', default='ws1s', choices=['ws1s', 'm2l-str', 'both'], help='logic of the series')
+    parser.add_argument('--alternation', default=1, type=int, help='quantifier alternation depth of the series')
+    parser.add_argument('--variables', default=4, type=int, help='number of quantified variables of the series')
+    parser.add_argument('--width', default=None, type=int, help='conjunction width of the series [variables - 1]')
+    parser.add_argument('--nesting', default=0, type=int, help='predicate nesting depth of the series')
     return parser
 
 def parse_arguments():
@@ -208,6 +217,115 @@ def generate_veanes(n, alt):
     return string
 
 
+# methods for generating scaling series
+series_params = ['alternation', 'variables', 'width', 'nesting']
+
+
+def clamp_scaling(params):
+    '''
+    Clamps the parameters of the scaling formula to the values that are actually generated
+
+    @param params: dictionary with alternation, variables, width (None for default) and nesting
+    @return: dictionary with clamped parameters
+    '''
+    clamped = dict(params)
+    clamped['alternation'] = max(params['alternation'], 1)
+    clamped['variables'] = max(params['variables'], clamped['alternation'], 2)
+    clamped['width'] = max(params['width'], 1) if params['width'] is not None else clamped['variables'] - 1
+    clamped['nesting'] = max(params['nesting'], 0)
+    return clamped
+
+
+def generate_scaling(logic, alternation, variables, width, nesting):
+    '''
+    Generate horn-like formula parametrized by every dimension in form of:
+
+    logic;
+    pred p0(var2 A, var2 B, var2 S) = (A sub S & A ~= B) => B sub S;
+    pred pk(var2 A, var2 B, var2 S) = ex2 C: A sub C & pk-1(C, B, S);
+    ex2 X: all2 X1..: ex2 ..: ... : & pk(Xi, Xj, X)
+
+    @param logic: ws1s or m2l-str
+    @param alternation: number of alternating blocks of quantifiers after ex2 X (at least one)
+    @param variables: number of quantified variables X1..Xn (at least one per block)
+    @param width: number of conjuncts of the matrix
+    @param nesting: nesting depth of the predicate used in conjuncts
+    '''
+    params = clamp_scaling({'alternation': alternation, 'variables': variables, 'width': width, 'nesting': nesting})
+    alternation, variables, width, nesting = params['alternation'], params['variables'], params['width'], params['nesting']
+    string = logic + ";\n"
+
+    # predicates are nested linearly, so the size of unfolded formula grows linearly as well
+    if nesting > 0:
+        string += "pred p0(var2 A, var2 B, var2 S) = (A sub S & A ~= B) => B sub S;\n"
+        for i in range(1, nesting + 1):
+            string += "pred p{0}(var2 A, var2 B, var2 S) = ex2 C: A sub C & p{1}(C, B, S);\n".format(i, i - 1)
+
+    # variables are split evenly into the alternating blocks, starting with universal one
+    string += "ex2 X: "
+    blocks = [[] for _ in range(alternation)]
+    for i in range(variables):
+        blocks[i * alternation // variables].append("X" + str(i + 1))
+    for (i, block) in enumerate(blocks):
+        string += ("all2 " if i % 2 == 0 else "ex2 ") + ", ".join(block) + ": "
+
+    # conjuncts go through the chain X1 -> X2 -> .. and then through more distant pairs
+    clauses = []
+    for j in range(width):
+        lhs = j % variables
+        rhs = (lhs + 1 + (j // variables) % (variables - 1)) % variables
+        if nesting > 0:
+            clauses.append("p{0}(X{1}, X{2}, X)".format(nesting, lhs + 1, rhs + 1))
+        else:
+            clauses.append("((X{0} sub X & X{0} ~= X{1}) => X{1} sub X)".format(lhs + 1, rhs + 1))
+    string += " & ".join(clauses) + ";"
+    return string
+
+
+def generate_series(options):
+    '''
+    Generates the scaling series sweeping one of the parameters, each series is stored in separate directory
+    together with manifest.json, that maps the formulae to the value of swept parameter
+
+    @param options: parsed arguments
+    '''
+    param, start, end = options.series[0], int(options.series[1]), int(options.series[2])
+    if param not in series_params:
+        print("[!] Unknown parameter '{}', use one of: {}".format(param, ", ".join(series_params)))
+        quit()
+    logics = ['ws1s', 'm2l-str'] if options.logic == 'both' else [options.logic]
+    zeroFill = max(3, len(str(end)))
+
+    for logic in logics:
+        series_name = "{}-{}".format(param, logic)
+        series_dir = os.path.join(options.dir, "[scaling] " + series_name)
+        if not os.path.isdir(series_dir):
+            os.makedirs(series_dir)
+
+        fixed = {'alternation': options.alternation, 'variables': options.variables,
+                 'width': options.width, 'nesting': options.nesting}
+        formulae = []
+        for n in range(start, end + 1, options.step):
+            params = dict(fixed)
+            params[param] = n
+            # manifest records the clamped parameters, i.e. those the formula was generated with
+            params = clamp_scaling(params)
+            formula = generate_scaling(logic, params['alternation'], params['variables'], params['width'], params['nesting'])
+            output_name = "{}-{}.mona".format(series_name, str(n).zfill(zeroFill))
+            with open(os.path.join(series_dir, output_name), 'w') as file:
+                file.write(formula)
+            formulae.append({'file': output_name, 'value': params[param], 'params': params})
+
+        # parameters clamped differently along the series (e.g. variables by alternation) are not fixed
+        fixed = {key: formulae[0]['params'][key] for key in fixed
+                 if key != param and formulae and all(f['params'][key] == formulae[0]['params'][key] for f in formulae)}
+        manifest = {'series': series_name, 'parameter': param, 'logic': logic, 'fixed': fixed,
+                    'generated': datetime.now().strftime("%Y-%m-%d %H:%M:%S"), 'formulae': formulae}
+        with open(os.path.join(series_dir, "manifest.json"), 'w') as file:
+            json.dump(manifest, file, indent=2, sort_keys=True)
+        print("[*] Generated {} formulae of series '{}' into '{}'".format(len(formulae), series_name, series_dir))
+
+
 def generate_formulae(options, benchmark_name, up_to, alts, generator, zeroFill):
     for i in range(1, up_to + 1):
         if alts == 0 and benchmark_name != "veanes":
@@ -226,6 +344,10 @@ if __name__ == '__main__':
 
     options = parse_arguments()
 
+    if options.series is not None:
+        generate_series(options)
+        quit()
+
     # we will generate stuff
     generate_alternating = options.generate_alt is not None
     if not generate_alternating: